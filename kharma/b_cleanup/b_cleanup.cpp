@@ -58,6 +58,8 @@ void B_Cleanup::CleanupDivergence(std::shared_ptr<MeshData<Real>>& md) {}
 #include <parthenon/parthenon.hpp>
 // This is now part of KHARMA, but builds on some stuff not in all Parthenon versions
 #include "bicgstab_solver.hpp"
+#include "fft_poisson.hpp"
+#include "mg_preconditioner.hpp"
 
 using namespace parthenon;
 using namespace parthenon::solvers;
@@ -89,6 +91,32 @@ std::shared_ptr<KHARMAPackage> B_Cleanup::Initialize(ParameterInput *pin, std::s
     bool use_normalized_divb = pin->GetOrAddBoolean("b_cleanup", "use_normalized_divb", false);
     params.Add("use_normalized_divb", use_normalized_divb);
 
+    // Solver. "fft" inverts the Laplacian directly rather than iterating, but only supports
+    // uniform, periodic meshes in Cartesian Minkowski coordinates.  See fft_poisson.hpp
+    std::string solver_type = pin->GetOrAddString("b_cleanup", "solver", "bicgstab");
+    if (solver_type != "bicgstab" && solver_type != "fft")
+        throw std::invalid_argument("Unknown B field cleanup solver "+solver_type+"! Use bicgstab or fft");
+#if !USE_FFTW
+    if (solver_type == "fft")
+        throw std::runtime_error("KHARMA was compiled without FFTW!  Cannot clean B field with an FFT!");
+#endif
+    params.Add("solver_type", solver_type);
+
+    // Preconditioner. "multigrid" runs V-cycles within each meshblock, which makes the
+    // iteration count roughly independent of the block size, leaving only its dependence on the
+    // number of blocks.  See mg_preconditioner.hpp
+    std::string preconditioner = pin->GetOrAddString("b_cleanup", "preconditioner", "none");
+    if (preconditioner != "none" && preconditioner != "multigrid")
+        throw std::invalid_argument("Unknown B field cleanup preconditioner "+preconditioner+"! Use none or multigrid");
+    params.Add("preconditioner", preconditioner);
+    // Number of levels including the meshblock itself. <= 0 coarsens as far as the block size allows
+    int mg_levels = pin->GetOrAddInteger("b_cleanup", "mg_levels", 0);
+    params.Add("mg_levels", mg_levels);
+    int mg_smooth_iterations = pin->GetOrAddInteger("b_cleanup", "mg_smooth_iterations", 2);
+    params.Add("mg_smooth_iterations", mg_smooth_iterations);
+    int mg_coarse_iterations = pin->GetOrAddInteger("b_cleanup", "mg_coarse_iterations", 30);
+    params.Add("mg_coarse_iterations", mg_coarse_iterations);
+
     // Finally, initialize the solver
     // Translate parameters
     params.Add("bicgstab_max_iterations", max_iterations);
@@ -96,6 +124,7 @@ std::shared_ptr<KHARMAPackage> B_Cleanup::Initialize(ParameterInput *pin, std::s
     params.Add("bicgstab_abort_on_fail", fail_without_convergence);
     params.Add("bicgstab_warn_on_fail", warn_without_convergence);
     params.Add("bicgstab_print_checks", true);
+    params.Add("bicgstab_precondition", preconditioner != "none");
 
     // Sparse matrix.  Never built, we leave it blank
     pkg->AddParam<std::string>("spm_name", "");
@@ -261,13 +290,37 @@ TaskStatus B_Cleanup::CleanupDivergence(std::shared_ptr<MeshData<Real>>& md)
     // make sure divB_RHS is sync'd
     KHARMADriver::SyncAllBounds(msolve);
 
-    // Create a TaskCollection of just the solve,
-    // execute it to perform BiCGStab iteration
-    TaskID t_none(0);
-    TaskCollection tc;
-    auto tr = tc.AddRegion(1);
-    auto t_solve_step = solver.CreateTaskList(t_none, 0, tr, msolve, msolve);
-    while (!tr.Execute());
+    if (pkg->Param<std::string>("solver_type") == "fft") {
+        // Solve directly.  Cartesian Minkowski has gdet == 1, so normalization makes no difference
+        if (MPIRank0() && verbose > 0) {
+            std::cout << "Solving for potential with FFT" << std::endl;
+        }
+        FFTPoisson fft(msolve.get());
+        fft.Solve(msolve.get(), "RHS_divB", "p");
+    } else {
+        // Set up the preconditioner for this mesh, if we're using one
+        std::shared_ptr<MGPreconditioner> mg;
+        if (pkg->Param<std::string>("preconditioner") == "multigrid") {
+            mg = std::make_shared<MGPreconditioner>(msolve.get(), pkg->Param<int>("mg_levels"),
+                                                    pkg->Param<int>("mg_smooth_iterations"),
+                                                    pkg->Param<int>("mg_coarse_iterations"), use_normalized);
+            if (MPIRank0() && verbose > 0) {
+                std::cout << "Preconditioning with " << mg->NumLevels() << "-level multigrid" << std::endl;
+            }
+            solver.user_Precondition = [mg](MeshData<Real> *md, const std::string &in_var,
+                                            MeshData<Real> *md_out, const std::string &out_var) {
+                return mg->Apply(md, in_var, md_out, out_var);
+            };
+        }
+
+        // Create a TaskCollection of just the solve,
+        // execute it to perform BiCGStab iteration
+        TaskID t_none(0);
+        TaskCollection tc;
+        auto tr = tc.AddRegion(1);
+        auto t_solve_step = solver.CreateTaskList(t_none, 0, tr, msolve, msolve);
+        while (!tr.Execute());
+    }
     // Make sure solution's ghost zones are sync'd
     KHARMADriver::SyncAllBounds(msolve);
 
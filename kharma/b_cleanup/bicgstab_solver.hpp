@@ -13,6 +13,7 @@
 #ifndef SOLVERS_BICGSTAB_SOLVER_HPP_
 #define SOLVERS_BICGSTAB_SOLVER_HPP_
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -25,6 +26,7 @@
 #include "tasks/task_id.hpp"
 #include "tasks/task_list.hpp"
 
+#include "reductions/reductions_types.hpp"
 #include "solver_utils.hpp"
 
 namespace parthenon {
@@ -47,11 +49,16 @@ class BiCGStabSolver : BiCGStabCounter {
         sp_accessor(sp), max_iters(pkg->Param<int>("bicgstab_max_iterations")),
         check_interval(pkg->Param<int>("bicgstab_check_interval")),
         fail_flag(pkg->Param<bool>("bicgstab_abort_on_fail")),
-        warn_flag(pkg->Param<bool>("bicgstab_warn_on_fail")), aux_vars(aux_vars) {
+        warn_flag(pkg->Param<bool>("bicgstab_warn_on_fail")),
+        precondition(pkg->Param<bool>("bicgstab_precondition")), aux_vars(aux_vars) {
     Init(pkg, user_flags);
   }
   std::vector<std::string> SolverState() const {
     std::vector<std::string> vars{spm_name, rhs_name, res, res0, vk, pk, tk, temp};
+    if (precondition) {
+      vars.push_back(pk_hat);
+      vars.push_back(res_hat);
+    }
     vars.insert(vars.end(), aux_vars.begin(), aux_vars.end());
     return vars;
   }
@@ -81,6 +88,8 @@ class BiCGStabSolver : BiCGStabCounter {
   FMatVec user_precomm_MatVec;
   FScale user_precomm_scale;
   FScale user_postcomm_scale;
+  // Applies M^-1 for right-preconditioning. Required if "bicgstab_precondition" is set
+  FMatVec user_Precondition;
 
   std::vector<std::string> aux_vars;
 
@@ -118,6 +127,17 @@ class BiCGStabSolver : BiCGStabCounter {
     pkg->AddField(res, meta);
     pkg->AddField(temp, meta);
 
+    // Preconditioned search directions M^-1 p and M^-1 s.  Without a preconditioner
+    // these are just p and s
+    pk_hat = pk;
+    res_hat = res;
+    if (precondition) {
+      pk_hat = "pk_hat" + bicg_id;
+      res_hat = "res_hat" + bicg_id;
+      pkg->AddField(pk_hat, meta);
+      pkg->AddField(res_hat, meta);
+    }
+
     global_num_bicgstab_solvers++;
   }
 
@@ -130,14 +150,17 @@ class BiCGStabSolver : BiCGStabCounter {
     TaskList &tl = tr[i];
     RegionCounter reg(solver_name);
 
+    PARTHENON_REQUIRE(!precondition || user_Precondition,
+                      "BiCGStab was declared preconditioned, but has no preconditioner!");
+
     // initialize some shared state
     bicgstab_cntr = 0;
     global_res0.val = 0.0;
-    global_res.val = 0.0;
-    rhoi.val = 0.0;
+    global_res = 0.0;
+    rhoi = 0.0;
     r0_dot_vk.val = 0.0;
-    t_dot_s.val = 0.0;
-    t_dot_t.val = 0.0;
+    omega_dots.val = std::vector<Real>(n_dots, 0.0);
+    res_dot.val = 0.0;
 
     auto MatVec = [this](auto &task_list, const TaskID &init_depend,
                          std::shared_ptr<MeshData<Real>> &spmd,
@@ -214,23 +237,24 @@ class BiCGStabSolver : BiCGStabCounter {
         tl.AddTask(start_global_res0, &AllReduce<Real>::CheckReduce, &global_res0);
     tr.AddRegionalDependencies(reg.ID(), i, finish_global_res0);
 
-    // 1. \hat{r}_0 \cdot r_{i-1}
-    auto get_rhoi = solver.AddTask(init_bicgstab, &Solver_t::DotProduct<MD_t>, this,
-                                   md.get(), res0, res, &rhoi.val);
-    tr.AddRegionalDependencies(reg.ID(), i, get_rhoi);
-    auto start_global_rhoi =
-        (i == 0 ? solver.AddTask(get_rhoi, &AllReduce<Real>::StartReduce, &rhoi, MPI_SUM)
-                : get_rhoi);
-    auto finish_global_rhoi =
-        solver.AddTask(start_global_rhoi, &AllReduce<Real>::CheckReduce, &rhoi);
+    // There are only two global reductions per iteration: \hat{r}_0 \cdot v_i, and
+    // all of the dot products involving t & s together.  The latter also give the next
+    // rho_i and the residual norm, by expanding r_i = s - \omega t.
 
+    // 1. \hat{r}_0 \cdot r_{i-1} [From the previous iteration, or |r_0|^2 initially]
     // 2. \beta = (rho_i/rho_{i-1}) (\alpha / \omega_{i-1})
     // 3. p_i = r_{i-1} + \beta (p_{i-1} - \omega_{i-1} v_{i-1})
     auto update_pk =
-        solver.AddTask(finish_global_rhoi, &Solver_t::Compute_pk<MD_t>, this, md.get());
+        solver.AddTask(finish_global_res0, &Solver_t::Compute_pk<MD_t>, this, md.get());
+
+    // 3a. \hat{p} = M^{-1} p_i
+    auto precon_pk = update_pk;
+    if (precondition) {
+      precon_pk = solver.AddTask(update_pk, user_Precondition, md.get(), pk, md.get(), pk_hat);
+    }
 
-    // 4. v = A p
-    auto get_v = MatVec(solver, update_pk, md, pk, vk);
+    // 4. v = A \hat{p}
+    auto get_v = MatVec(solver, precon_pk, md, pk_hat, vk);
 
     // 5. alpha = rho_i / (\hat{r}_0 \cdot v_i) [Actually just calculate \hat{r}_0 \cdot
     // v_i]
@@ -245,47 +269,53 @@ class BiCGStabSolver : BiCGStabCounter {
         solver.AddTask(start_global_r0dotv, &AllReduce<Real>::CheckReduce, &r0_dot_vk);
     // alpha is actually updated in this next task
 
-    // 6. h = x_{i-1} + alpha p [Really updates x_i]
+    // 6. h = x_{i-1} + alpha \hat{p} [Really updates x_i]
     // 7. check for convergence [Not actually done]
     // 8. s = r_{i-1} - alpha v
     auto get_s = solver.AddTask(finish_global_r0dotv, &Solver_t::Update_h_and_s<MD_t>,
                                 this, md.get(), mout.get());
 
-    // 9. t = A s
-    auto get_t = MatVec(solver, get_s, md, res, tk);
+    // 8a. \hat{s} = M^{-1} s
+    auto precon_s = get_s;
+    if (precondition) {
+      precon_s = solver.AddTask(get_s, user_Precondition, md.get(), res, md.get(), res_hat);
+    }
+
+    // 9. t = A \hat{s}
+    auto get_t = MatVec(solver, precon_s, md, res_hat, tk);
 
-    // 10. omega = (t \cdot s) / (t \cdot t)
-    auto get_tdots = solver.AddTask(get_t, &Solver_t::OmegaDotProd<MD_t>, this, md.get(),
-                                    &t_dot_s.val, &t_dot_t.val);
+    // 10. omega = (t \cdot s) / (t \cdot t) [Also reduces \hat{r}_0 \cdot s,
+    // \hat{r}_0 \cdot t and s \cdot s, in one vector reduction]
+    auto get_tdots = solver.AddTask(get_t, &Solver_t::OmegaDotProds<MD_t>, this, md.get(),
+                                    &omega_dots.val);
     tr.AddRegionalDependencies(reg.ID(), i, get_tdots);
     auto start_global_tdots =
-        (i == 0
-             ? solver.AddTask(get_tdots, &AllReduce<Real>::StartReduce, &t_dot_s, MPI_SUM)
-             : get_tdots);
-    auto finish_global_tdots =
-        solver.AddTask(start_global_tdots, &AllReduce<Real>::CheckReduce, &t_dot_s);
-    auto start_global_tdott =
-        (i == 0
-             ? solver.AddTask(get_tdots, &AllReduce<Real>::StartReduce, &t_dot_t, MPI_SUM)
-             : get_tdots);
-    auto finish_global_tdott =
-        solver.AddTask(start_global_tdott, &AllReduce<Real>::CheckReduce, &t_dot_t);
+        (i == 0 ? solver.AddTask(get_tdots, &AllReduce<std::vector<Real>>::StartReduce,
+                                 &omega_dots, MPI_SUM)
+                : get_tdots);
+    auto finish_global_tdots = solver.AddTask(
+        start_global_tdots, &AllReduce<std::vector<Real>>::CheckReduce, &omega_dots);
     // omega is actually updated in this next task
 
     // 11. update x and residual
-    auto update_x = solver.AddTask(finish_global_tdots | finish_global_tdott,
-                                   &Solver_t::Update_x_res<MD_t>, this, md.get(),
-                                   mout.get(), &global_res.val);
+    auto update_x = solver.AddTask(finish_global_tdots, &Solver_t::Update_x_res<MD_t>,
+                                   this, md.get(), mout.get());
     tr.AddRegionalDependencies(reg.ID(), i, update_x);
-    auto start_global_res =
-        (i == 0 ? solver.AddTask(update_x, &AllReduce<Real>::StartReduce, &global_res,
-                                 MPI_SUM)
-                : update_x);
-    auto finish_global_res =
-        solver.AddTask(start_global_res, &AllReduce<Real>::CheckReduce, &global_res);
 
-    // 12. check for convergence
-    auto check = solver.SetCompletionTask(finish_global_res, &Solver_t::CheckConvergence,
+    // 11a. r_i \cdot r_i, computed directly [Only every check_interval iterations, and
+    // whenever the recurrence claims convergence.  Otherwise these tasks do nothing]
+    auto get_rdotr = solver.AddTask(update_x, &Solver_t::ResidualDotProduct<MD_t>, this,
+                                    md.get(), &res_dot.val);
+    tr.AddRegionalDependencies(reg.ID(), i, get_rdotr);
+    auto start_global_rdotr =
+        (i == 0 ? solver.AddTask(get_rdotr, &Solver_t::StartResidualReduce, this)
+                : get_rdotr);
+    auto finish_global_rdotr =
+        solver.AddTask(start_global_rdotr, &Solver_t::CheckResidualReduce, this);
+
+    // 12. check for convergence [Computes the new rho_i and |r_i| from the reduced dots,
+    // or takes |r_i| from 11a when it was computed]
+    auto check = solver.SetCompletionTask(finish_global_rdotr, &Solver_t::CheckConvergence,
                                           this, i, true);
     tr.AddGlobalDependencies(reg.ID(), i, check);
 
@@ -409,16 +439,18 @@ class BiCGStabSolver : BiCGStabCounter {
     const int ires0 = imap[res0].first;
     const int ivk = imap[vk].first;
 
-    const Real beta = (rhoi.val / rhoi_old) * (alpha_old / omega_old);
+    // r_0 = \hat{r}_0 = rhs, so the first rho_i is just the (squared) initial residual
+    if (bicgstab_cntr == 0) rhoi = global_res0.val;
+    const Real beta = (rhoi / rhoi_old) * (alpha_old / omega_old);
     bool reset = false;
-    // if (std::abs(rhoi.val) < 1.e-8) {
+    // if (std::abs(rhoi) < 1.e-8) {
     //   // Reset
-    //   printf("Resetting (r_{i-1}, r_0) = %e res = %e \n", rhoi.val, res_old);
-    //   rhoi.val = res_old; // this should be the norm of the old residual, which we are
+    //   printf("Resetting (r_{i-1}, r_0) = %e res = %e \n", rhoi, res_old);
+    //   rhoi = res_old; // this should be the norm of the old residual, which we are
     //   resetting to reset = true;
     // }
     // printf("Compute_pk: rho_i = %e rho_{i-1} = %e alpha_old = %e omega_old = %e beta =
-    // %e\n", rhoi.val, rhoi_old, alpha_old, omega_old, beta); rhoi_old = rhoi.val;
+    // %e\n", rhoi, rhoi_old, alpha_old, omega_old, beta); rhoi_old = rhoi;
     const Real w_o = omega_old;
     par_for(
         DEFAULT_LOOP_PATTERN, "compute pk", DevExecSpace(), 0, v.GetDim(5) - 1, kb.s,
@@ -476,14 +508,14 @@ class BiCGStabSolver : BiCGStabCounter {
     const auto kb = IndexRange{kbi.s, kbi.e + (ndim > 2)};
 
     PackIndexMap imap;
-    auto &v = u->PackVariables(std::vector<std::string>({res, pk, vk}), imap);
+    auto &v = u->PackVariables(std::vector<std::string>({res, pk_hat, vk}), imap);
     auto &dv = du->PackVariables(std::vector<std::string>({sol_name}));
     const int ires = imap[res].first;
-    const int ipk = imap[pk].first;
+    const int ipk = imap[pk_hat].first;
     const int ivk = imap[vk].first;
 
-    Real alpha = rhoi.val / r0_dot_vk.val;
-    // printf("alpha = %e rho = %e (v, r_0) = %e\n", alpha, rhoi.val, r0_dot_vk.val);
+    Real alpha = rhoi / r0_dot_vk.val;
+    // printf("alpha = %e rho = %e (v, r_0) = %e\n", alpha, rhoi, r0_dot_vk.val);
     if (std::abs(r0_dot_vk.val) < 1.e-200) alpha = 0.0;
     par_for(
         DEFAULT_LOOP_PATTERN, "Update_h", DevExecSpace(), 0, v.GetDim(5) - 1, kb.s, kb.e,
@@ -507,8 +539,8 @@ class BiCGStabSolver : BiCGStabCounter {
 
     auto &v = u->PackVariables(std::vector<std::string>({pk}));
     auto &dv = du->PackVariables(std::vector<std::string>({sol_name}));
-    Real alpha = rhoi.val / r0_dot_vk.val;
-    // printf("Update_h: r0_dot_vk = %e rhoi = %e alpha = %e\n", r0_dot_vk.val, rhoi.val,
+    Real alpha = rhoi / r0_dot_vk.val;
+    // printf("Update_h: r0_dot_vk = %e rhoi = %e alpha = %e\n", r0_dot_vk.val, rhoi,
     // alpha);
     par_for(
         DEFAULT_LOOP_PATTERN, "Update_h", DevExecSpace(), 0, v.GetDim(5) - 1, kb.s, kb.e,
@@ -533,8 +565,8 @@ class BiCGStabSolver : BiCGStabCounter {
     auto &v = u->PackVariables(std::vector<std::string>({res, vk}), imap);
     const int ires = imap[res].first;
     const int ivk = imap[vk].first;
-    Real alpha = rhoi.val / r0_dot_vk.val;
-    // printf("Update_s: r0_dot_vk = %e rhoi = %e alpha = %e\n", r0_dot_vk.val, rhoi.val,
+    Real alpha = rhoi / r0_dot_vk.val;
+    // printf("Update_s: r0_dot_vk = %e rhoi = %e alpha = %e\n", r0_dot_vk.val, rhoi,
     // alpha);
     par_for(
         DEFAULT_LOOP_PATTERN, "Update_s", DevExecSpace(), 0, v.GetDim(5) - 1, kb.s, kb.e,
@@ -546,7 +578,7 @@ class BiCGStabSolver : BiCGStabCounter {
   }
 
   template <typename T>
-  TaskStatus OmegaDotProd(T *u, Real *t_dot_s, Real *t_dot_t) {
+  TaskStatus OmegaDotProds(T *u, std::vector<Real> *dots) {
     const auto &ibi = u->GetBoundsI(IndexDomain::interior);
     const auto &jbi = u->GetBoundsJ(IndexDomain::interior);
     const auto &kbi = u->GetBoundsK(IndexDomain::interior);
@@ -555,35 +587,35 @@ class BiCGStabSolver : BiCGStabCounter {
     const auto jb = IndexRange{jbi.s, jbi.e + (ndim > 1)};
     const auto kb = IndexRange{kbi.s, kbi.e + (ndim > 2)};
 
-    auto &v = u->PackVariables(std::vector<std::string>({tk, res}));
-
-    // TODO(JCD): these should probably be merged
-    Real ts_sum(0);
-    par_reduce(
-        loop_pattern_mdrange_tag, "tk dot sk", DevExecSpace(), 0, v.GetDim(5) - 1, kb.s,
-        kb.e, jb.s, jb.e, ib.s, ib.e,
-        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &lsum) {
-          lsum += v(b, 0, k, j, i) * v(b, 1, k, j, i);
-        },
-        Kokkos::Sum<Real>(ts_sum));
-    *t_dot_s += ts_sum;
+    PackIndexMap imap;
+    auto &v = u->PackVariables(std::vector<std::string>({tk, res, res0}), imap);
+    const int itk = imap[tk].first;
+    const int ires = imap[res].first;
+    const int ires0 = imap[res0].first;
 
-    Real tt_sum(0);
+    using dots_t = Reductions::array_type<Real, n_dots>;
+    dots_t sums;
     par_reduce(
-        loop_pattern_mdrange_tag, "tk dot sk", DevExecSpace(), 0, v.GetDim(5) - 1, kb.s,
-        kb.e, jb.s, jb.e, ib.s, ib.e,
-        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &lsum) {
-          lsum += v(b, 0, k, j, i) * v(b, 0, k, j, i);
+        loop_pattern_mdrange_tag, "omega dot products", DevExecSpace(), 0,
+        v.GetDim(5) - 1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, dots_t &lsum) {
+          const Real t = v(b, itk, k, j, i);
+          const Real s = v(b, ires, k, j, i);
+          const Real r0 = v(b, ires0, k, j, i);
+          lsum.my_array[dot_ts] += t * s;
+          lsum.my_array[dot_tt] += t * t;
+          lsum.my_array[dot_r0s] += r0 * s;
+          lsum.my_array[dot_r0t] += r0 * t;
+          lsum.my_array[dot_ss] += s * s;
         },
-        Kokkos::Sum<Real>(tt_sum));
-    *t_dot_t += tt_sum;
-    // printf("OmegaDotProd: t_dot_s = %e (%e) t_dot_t = %e (%e)\n", *t_dot_s, ts_sum,
-    // *t_dot_t, tt_sum);
+        Reductions::ArraySum<Real, HostExecSpace, n_dots>(sums));
+    for (int n = 0; n < n_dots; ++n)
+      (*dots)[n] += sums.my_array[n];
     return TaskStatus::complete;
   }
 
   template <typename T>
-  TaskStatus Update_x_res(T *u, T *du, Real *gres) {
+  TaskStatus Update_x_res(T *u, T *du) {
     const auto &ibi = u->GetBoundsI(IndexDomain::interior);
     const auto &jbi = u->GetBoundsJ(IndexDomain::interior);
     const auto &kbi = u->GetBoundsK(IndexDomain::interior);
@@ -593,42 +625,58 @@ class BiCGStabSolver : BiCGStabCounter {
     const auto kb = IndexRange{kbi.s, kbi.e + (ndim > 2)};
 
     PackIndexMap imap;
-    auto &v = u->PackVariables(std::vector<std::string>({res, tk}), imap);
+    std::vector<std::string> vars({res, tk});
+    if (precondition) vars.push_back(res_hat);
+    auto &v = u->PackVariables(vars, imap);
     const int ires = imap[res].first;
     const int itk = imap[tk].first;
+    const int ires_hat = imap[res_hat].first;
     auto &dv = du->PackVariables(std::vector<std::string>({sol_name}));
-    Real omega = t_dot_s.val / t_dot_t.val;
-    if (std::abs(t_dot_t.val) < 1.e-200) omega = 0.0;
-    Real err(0);
-    par_reduce(
-        loop_pattern_mdrange_tag, "Update_x", DevExecSpace(), 0, v.GetDim(5) - 1, kb.s,
-        kb.e, jb.s, jb.e, ib.s, ib.e,
-        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i, Real &lerr) {
-          dv(b, 0, k, j, i) += omega * v(b, ires, k, j, i);
+    const Real omega = Omega();
+    par_for(
+        DEFAULT_LOOP_PATTERN, "Update_x", DevExecSpace(), 0, v.GetDim(5) - 1, kb.s, kb.e,
+        jb.s, jb.e, ib.s, ib.e,
+        KOKKOS_LAMBDA(const int b, const int k, const int j, const int i) {
+          dv(b, 0, k, j, i) += omega * v(b, ires_hat, k, j, i);
           v(b, ires, k, j, i) -= omega * v(b, itk, k, j, i);
-          lerr += v(b, ires, k, j, i) * v(b, ires, k, j, i);
-        },
-        Kokkos::Sum<Real>(err));
-    *gres += err;
+        });
     return TaskStatus::complete;
   }
 
+  template <typename T>
+  TaskStatus ResidualDotProduct(T *u, Real *reduce_sum) {
+    if (!CheckTrueResidual()) return TaskStatus::complete;
+    return DotProduct(u, res, res, reduce_sum);
+  }
+
+  TaskStatus StartResidualReduce() {
+    return CheckTrueResidual() ? res_dot.StartReduce(MPI_SUM) : TaskStatus::complete;
+  }
+
+  TaskStatus CheckResidualReduce() {
+    return CheckTrueResidual() ? res_dot.CheckReduce() : TaskStatus::complete;
+  }
+
   TaskStatus CheckConvergence(const int &i, bool report) {
     if (i != 0) return TaskStatus::complete;
+    // Must be decided before the counter & initial residual are updated
+    const bool true_res = CheckTrueResidual();
     bicgstab_cntr++;
-    global_res.val = std::sqrt(global_res.val);
     if (bicgstab_cntr == 1) global_res0.val = std::sqrt(global_res0.val);
 
-    // printf("rhoi: %e r0_dot_vk: %e t_dot_t: %e\n", rhoi.val, r0_dot_vk.val,
-    // t_dot_s.val);
     //  Update global scalars
-    rhoi_old = rhoi.val;
-    alpha_old = rhoi.val / r0_dot_vk.val;
-    omega_old = t_dot_s.val / t_dot_t.val;
-    res_old = global_res.val;
-
-    bool converged = std::abs(global_res.val / global_res0.val) < rel_error_tol
-                    || std::abs(global_res.val) < abs_error_tol;
+    const auto &dots = omega_dots.val;
+    const Real omega = Omega();
+    rhoi_old = rhoi;
+    alpha_old = rhoi / r0_dot_vk.val;
+    omega_old = dots[dot_ts] / dots[dot_tt];
+    // r_i = s - \omega t, so expand the next \hat{r}_0 \cdot r_i
+    rhoi = dots[dot_r0s] - omega * dots[dot_r0t];
+    global_res = (true_res) ? std::sqrt(res_dot.val) : FusedResidual();
+    res_old = global_res;
+
+    bool converged = std::abs(global_res / global_res0.val) < rel_error_tol
+                    || std::abs(global_res) < abs_error_tol;
 
     bool stop = bicgstab_cntr == max_iters;
     if (std::abs(alpha_old) < 1.e-8 && std::abs(omega_old) < 1.e-8) stop = true;
@@ -636,38 +684,63 @@ class BiCGStabSolver : BiCGStabCounter {
       if (Globals::my_rank == 0) {
         std::cout << " its= " << bicgstab_cntr << " rho= " << rhoi_old
                   << " alpha= " << alpha_old << " omega= " << omega_old
-                  << " relative-res: " << global_res.val / global_res0.val
-                  << " absolute-res: " << global_res.val
+                  << " relative-res: " << global_res / global_res0.val
+                  << " absolute-res: " << global_res
                   << " absolute-res0: " << global_res0.val << " relerr-tol: " << rel_error_tol
                   << " abserr-tol: " << abs_error_tol
                   << std::endl;
       }
     }
 
-    global_res.val = 0.0;
-    rhoi.val = 0.0;
     r0_dot_vk.val = 0.0;
-    t_dot_s.val = 0.0;
-    t_dot_t.val = 0.0;
+    std::fill(omega_dots.val.begin(), omega_dots.val.end(), 0.0);
+    res_dot.val = 0.0;
 
     return converged || stop ? TaskStatus::complete : TaskStatus::iterate;
   }
 
  private:
+  // Entries of the fused reduction for omega, see CreateTaskList
+  enum { dot_ts = 0, dot_tt, dot_r0s, dot_r0t, dot_ss, n_dots };
+
+  Real Omega() const {
+    const auto &dots = omega_dots.val;
+    return (std::abs(dots[dot_tt]) < 1.e-200) ? 0.0 : dots[dot_ts] / dots[dot_tt];
+  }
+
+  // |r_i| from the fused dots, expanding r_i \cdot r_i with r_i = s - \omega t.
+  // Clamped at zero, as it is prone to cancellation once the residual is small
+  Real FusedResidual() const {
+    const auto &dots = omega_dots.val;
+    const Real omega = Omega();
+    return std::sqrt(std::max(
+        dots[dot_ss] - 2. * omega * dots[dot_ts] + omega * omega * dots[dot_tt], 0.0));
+  }
+
+  // Whether this iteration reduces r_i \cdot r_i directly: on every reported iteration, and
+  // before accepting convergence from the fused estimate.  Depends only on globally-reduced
+  // values, so all partitions and ranks agree
+  bool CheckTrueResidual() const {
+    if ((bicgstab_cntr + 1) % check_interval == 0) return true;
+    // The initial residual is kept squared until the first convergence check
+    const Real res0 = (bicgstab_cntr == 0) ? std::sqrt(global_res0.val) : global_res0.val;
+    const Real res_fused = FusedResidual();
+    return std::abs(res_fused / res0) < rel_error_tol || std::abs(res_fused) < abs_error_tol;
+  }
+
   Real rel_error_tol, abs_error_tol;
   SparseMatrixAccessor sp_accessor;
   int max_iters, check_interval, bicgstab_cntr;
-  bool fail_flag, warn_flag;
+  bool fail_flag, warn_flag, precondition;
   std::string spm_name, sol_name, rhs_name, res, res0, vk, pk, tk, temp, solver_name;
+  std::string pk_hat, res_hat;
 
-  Real rhoi_old, alpha_old, omega_old, res_old;
+  Real rhoi, rhoi_old, alpha_old, omega_old, res_old, global_res;
 
   AllReduce<Real> global_res0;
-  AllReduce<Real> global_res;
-  AllReduce<Real> rhoi;
   AllReduce<Real> r0_dot_vk;
-  AllReduce<Real> t_dot_s;
-  AllReduce<Real> t_dot_t;
+  AllReduce<std::vector<Real>> omega_dots;
+  AllReduce<Real> res_dot;
 };
 
 } // namespace solvers
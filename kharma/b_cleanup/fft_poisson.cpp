@@ -0,0 +1,202 @@
+/*
+ *  File: fft_poisson.cpp
+ *  
+ *  BSD 3-Clause License
+ *  
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *  
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *  
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *  
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "fft_poisson.hpp"
+
+#include "gr_coordinates.hpp"
+
+#include <algorithm>
+#include <climits>
+
+#if USE_FFTW
+#include "fftw3.h"
+#endif
+
+using namespace parthenon;
+
+namespace B_Cleanup {
+
+FFTPoisson::FFTPoisson(MeshData<Real> *md)
+{
+    auto pmesh = md->GetMeshPointer();
+    ndim = pmesh->ndim;
+    nblocks = md->NumBlocks();
+
+    if (pmesh->multilevel)
+        throw std::runtime_error("FFT B field cleanup requires a uniform mesh, without refinement!");
+    const auto& G = md->GetBlockData(0)->GetBlockPointer()->coords;
+    if (!mpark::holds_alternative<CartMinkowskiCoords>(G.coords.base) || G.coords.is_transformed())
+        throw std::runtime_error("FFT B field cleanup requires Cartesian Minkowski coordinates with no transform!");
+    const BoundaryFace inner[3] = {BoundaryFace::inner_x1, BoundaryFace::inner_x2, BoundaryFace::inner_x3};
+    const BoundaryFace outer[3] = {BoundaryFace::outer_x1, BoundaryFace::outer_x2, BoundaryFace::outer_x3};
+    for (int d = 0; d < ndim; ++d) {
+        if (pmesh->mesh_bcs[inner[d]] != BoundaryFlag::periodic || pmesh->mesh_bcs[outer[d]] != BoundaryFlag::periodic)
+            throw std::runtime_error("FFT B field cleanup requires periodic boundaries in all directions!");
+    }
+
+    const IndexRange ib = md->GetBoundsI(IndexDomain::interior);
+    const IndexRange jb = md->GetBoundsJ(IndexDomain::interior);
+    const IndexRange kb = md->GetBoundsK(IndexDomain::interior);
+    nblock[0] = ib.e - ib.s + 1;
+    nblock[1] = jb.e - jb.s + 1;
+    nblock[2] = kb.e - kb.s + 1;
+
+    const CoordinateDirection dirs[3] = {X1DIR, X2DIR, X3DIR};
+    GReal dx[3];
+    for (int d = 0; d < 3; ++d) {
+        nmesh[d] = (d < ndim) ? pmesh->mesh_size.nx(dirs[d]) : 1;
+        dx[d] = (pmesh->mesh_size.xmax(dirs[d]) - pmesh->mesh_size.xmin(dirs[d])) / pmesh->mesh_size.nx(dirs[d]);
+        scale[d] = (d < ndim) ? 1. / (dx[d] * dx[d]) : 0.;
+    }
+    for (int b = 0; b < nblocks; ++b) {
+        auto pmb = md->GetBlockData(b)->GetBlockPointer();
+        std::array<int, 3> off;
+        for (int d = 0; d < 3; ++d)
+            off[d] = (d < ndim) ? (int) m::round((pmb->block_size.xmin(dirs[d]) - pmesh->mesh_size.xmin(dirs[d])) / dx[d]) : 0;
+        offsets.push_back(off);
+    }
+}
+
+#if USE_FFTW
+
+TaskStatus FFTPoisson::Solve(MeshData<Real> *md, const std::string& rhs_var, const std::string& sol_var)
+{
+    const IndexRange ib = md->GetBoundsI(IndexDomain::interior);
+    const IndexRange jb = md->GetBoundsJ(IndexDomain::interior);
+    const IndexRange kb = md->GetBoundsK(IndexDomain::interior);
+
+    auto rhs = md->PackVariables(std::vector<std::string>{rhs_var});
+    auto sol = md->PackVariables(std::vector<std::string>{sol_var});
+
+    // Every physical node of each block, i.e. one extra on the right in each used direction
+    const int n1 = nblock[0] + 1, n2 = nblock[1] + (ndim > 1), n3 = nblock[2] + (ndim > 2);
+    ParArray4D<Real> buf("fft_buf", nblocks, n3, n2, n1);
+    parthenon::par_for(DEFAULT_LOOP_PATTERN, "fft_load", DevExecSpace(), 0, nblocks - 1,
+        0, n3 - 1, 0, n2 - 1, 0, n1 - 1,
+        KOKKOS_LAMBDA (const int& b, const int& k, const int& j, const int& i) {
+            buf(b, k, j, i) = rhs(b, 0, kb.s + k, jb.s + j, ib.s + i);
+        }
+    );
+    auto buf_h = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), buf);
+
+    // Row-major over the mesh, slowest index first as FFTW expects
+    const size_t ntot = (size_t) nmesh[0] * nmesh[1] * nmesh[2];
+    const int nc1 = nmesh[0] / 2 + 1;
+    const size_t nmodes = (size_t) nc1 * nmesh[1] * nmesh[2];
+    double *field = fftw_alloc_real(ntot);
+    fftw_complex *modes = fftw_alloc_complex(nmodes);
+    int dims[3];
+    for (int d = 0; d < ndim; ++d) dims[d] = nmesh[ndim - 1 - d];
+    // Plan before filling, since planning may overwrite the arrays
+    fftw_plan forward = fftw_plan_dft_r2c(ndim, dims, field, modes, FFTW_ESTIMATE);
+    fftw_plan backward = fftw_plan_dft_c2r(ndim, dims, modes, field, FFTW_ESTIMATE);
+
+    auto global_idx = [&](const int& b, const int& k, const int& j, const int& i) {
+        const auto& off = offsets[b];
+        return ((size_t) ((off[2] + k) % nmesh[2]) * nmesh[1] + (off[1] + j) % nmesh[1]) * nmesh[0]
+                + (off[0] + i) % nmesh[0];
+    };
+
+    // Gather the whole RHS.  Each block contributes only the nodes on its left edges,
+    // so blocks cover the mesh exactly once and a sum recovers it everywhere
+    for (size_t n = 0; n < ntot; ++n) field[n] = 0.;
+    for (int b = 0; b < nblocks; ++b)
+        for (int k = 0; k < nblock[2]; ++k)
+            for (int j = 0; j < nblock[1]; ++j)
+                for (int i = 0; i < nblock[0]; ++i)
+                    field[global_idx(b, k, j, i)] = buf_h(b, k, j, i);
+#ifdef MPI_PARALLEL
+    // MPI counts are ints, so meshes over INT_MAX cells are summed in pieces
+    for (size_t start = 0; start < ntot; start += INT_MAX) {
+        const int count = (int) std::min(ntot - start, (size_t) INT_MAX);
+        PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, field + start, count, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD));
+    }
+#endif
+
+    fftw_execute(forward);
+
+    // Divide by the eigenvalue of each mode, zeroing the null space.
+    // FFTW's transforms are unnormalized, so we also divide by the number of points
+    Real lam_max = 0.;
+    for (int d = 0; d < ndim; ++d) lam_max += 4 * scale[d];
+    for (int k = 0; k < nmesh[2]; ++k)
+        for (int j = 0; j < nmesh[1]; ++j)
+            for (int i = 0; i < nc1; ++i) {
+                const Real theta[3] = {2*M_PI*i / nmesh[0], 2*M_PI*j / nmesh[1], 2*M_PI*k / nmesh[2]};
+                Real lam = 0.;
+                for (int d = 0; d < ndim; ++d) {
+                    Real term = scale[d] * (2*m::cos(theta[d]) - 2);
+                    for (int e = 0; e < ndim; ++e)
+                        if (e != d) term *= (1 + m::cos(theta[e])) / 2;
+                    lam += term;
+                }
+                const Real inv = (m::abs(lam) > 1.e-12 * lam_max) ? 1. / (lam * ntot) : 0.;
+                const size_t n = ((size_t) k * nmesh[1] + j) * nc1 + i;
+                modes[n][0] *= inv;
+                modes[n][1] *= inv;
+            }
+
+    fftw_execute(backward);
+
+    // Scatter back, including the right edges of each block
+    for (int b = 0; b < nblocks; ++b)
+        for (int k = 0; k < n3; ++k)
+            for (int j = 0; j < n2; ++j)
+                for (int i = 0; i < n1; ++i)
+                    buf_h(b, k, j, i) = field[global_idx(b, k, j, i)];
+    Kokkos::deep_copy(buf, buf_h);
+    parthenon::par_for(DEFAULT_LOOP_PATTERN, "fft_store", DevExecSpace(), 0, nblocks - 1,
+        0, n3 - 1, 0, n2 - 1, 0, n1 - 1,
+        KOKKOS_LAMBDA (const int& b, const int& k, const int& j, const int& i) {
+            sol(b, 0, kb.s + k, jb.s + j, ib.s + i) = buf(b, k, j, i);
+        }
+    );
+
+    fftw_destroy_plan(forward);
+    fftw_destroy_plan(backward);
+    fftw_free(field);
+    fftw_free(modes);
+
+    return TaskStatus::complete;
+}
+
+#else
+
+TaskStatus FFTPoisson::Solve(MeshData<Real> *md, const std::string& rhs_var, const std::string& sol_var)
+{
+    throw std::runtime_error("Attempted to clean B field with an FFT, but KHARMA was compiled without FFT support!");
+}
+
+#endif
+
+} // namespace B_Cleanup
@@ -0,0 +1,85 @@
+/*
+ *  File: fft_poisson.hpp
+ *  
+ *  BSD 3-Clause License
+ *  
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *  
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *  
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *  
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <parthenon/parthenon.hpp>
+
+#include "decs.hpp"
+#include "types.hpp"
+
+using namespace parthenon;
+
+namespace B_Cleanup {
+
+/**
+ * Direct solve of the corner Laplacian by FFT, for uniform, periodic meshes in
+ * Cartesian Minkowski coordinates.
+ *
+ * The operator L = sum_d (1/dx_d^2) Lxx_d prod_{e!=d} S_e (see MGLevelOp) is diagonal in
+ * Fourier space, with eigenvalues
+ * sum_d (1/dx_d^2) (2 cos(theta_d) - 2) prod_{e!=d} (1 + cos(theta_e))/2.
+ * Its null space is the constant and the checkerboard modes in 2 or more directions.
+ * Any divergence computed by corner_div has no component along these, so dividing
+ * by the eigenvalue everywhere else gives the exact least-squares solution.
+ *
+ * The whole mesh is gathered to every rank and transformed there with serial FFTW,
+ * so this is meant for meshes that fit in memory on one rank.
+ */
+class FFTPoisson {
+    public:
+        /**
+         * Check that the mesh is supported and record its shape. Throws if not.
+         */
+        FFTPoisson(MeshData<Real> *md);
+
+        /**
+         * Set sol_var = L^-1 rhs_var on all physical nodes, i.e. including the right edge of each block.
+         */
+        TaskStatus Solve(MeshData<Real> *md, const std::string& rhs_var, const std::string& sol_var);
+
+    private:
+        int ndim, nblocks;
+        // Mesh and block size in zones, by direction
+        int nmesh[3], nblock[3];
+        // 1/dx^2 by direction
+        Real scale[3];
+        // Offset of each block within the mesh, in zones
+        std::vector<std::array<int, 3>> offsets;
+};
+
+} // namespace B_Cleanup
@@ -0,0 +1,308 @@
+/* 
+ *  File: mg_preconditioner.cpp
+ *  
+ *  BSD 3-Clause License
+ *  
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *  
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *  
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *  
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "mg_preconditioner.hpp"
+
+#include "gr_coordinates.hpp"
+
+using namespace parthenon;
+
+namespace B_Cleanup {
+
+/**
+ * Galerkin coarsening of each tridiagonal factor, see MGLevelOp.
+ * With off-diagonal o, interior diagonal d and end diagonal e on the fine level,
+ * P^T T P has off-diagonal o + d/4, diagonal 3d/2 + 2o, and end diagonal e + o + d/4.
+ */
+MGLevelOp CoarsenOp(const MGLevelOp& fine, const int& ndim)
+{
+    MGLevelOp coarse = fine;
+    for (int e = 0; e < ndim; ++e) {
+        coarse.n[e] = (fine.n[e] - 1) / 2 + 1;
+        for (int d = 0; d < ndim; ++d) {
+            const Real o = fine.off[d][e], dg = fine.diag[d][e], en = fine.end[d][e];
+            coarse.off[d][e] = o + dg / 4;
+            coarse.diag[d][e] = 1.5 * dg + 2 * o;
+            coarse.end[d][e] = en + o + dg / 4;
+        }
+    }
+    return coarse;
+}
+
+MGPreconditioner::MGPreconditioner(MeshData<Real> *md, const int& max_levels, const int& smooth_iterations,
+                                   const int& coarse_iterations, const bool& use_normalized)
+    : nsmooth(smooth_iterations), ncoarse(coarse_iterations), use_normalized(use_normalized)
+{
+    ndim = md->GetMeshPointer()->ndim;
+    nblocks = md->NumBlocks();
+    const IndexRange ib = md->GetBoundsI(IndexDomain::interior);
+    const IndexRange jb = md->GetBoundsJ(IndexDomain::interior);
+    const IndexRange kb = md->GetBoundsK(IndexDomain::interior);
+    const int nzones[3] = {ib.e - ib.s + 1, jb.e - jb.s + 1, kb.e - kb.s + 1};
+
+    // Coarsen as long as every direction has an even number of zones, and would keep at least 2
+    nlevels = 1;
+    while (max_levels <= 0 || nlevels < max_levels) {
+        bool can_coarsen = true;
+        for (int e = 0; e < ndim; ++e) {
+            const int nz = nzones[e] >> (nlevels - 1);
+            if (nz % 2 != 0 || nz < 4) can_coarsen = false;
+        }
+        if (!can_coarsen) break;
+        nlevels++;
+    }
+
+    // Plain V-cycle, plus one per checkerboard pattern in 2 or more directions
+    modulations.push_back(0);
+    for (int mask = 1; mask < (1 << ndim); ++mask)
+        if ((mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) >= 2)
+            modulations.push_back(mask);
+
+    // Finest level operator: second difference along d, corner averages along the others.
+    // Unused directions get the identity
+    MGLevelOp fine;
+    for (int e = 0; e < 3; ++e) {
+        fine.n[e] = (e < ndim) ? nzones[e] + 1 : 1;
+        for (int d = 0; d < 3; ++d) {
+            if (e >= ndim) {
+                fine.off[d][e] = 0.; fine.diag[d][e] = 1.; fine.end[d][e] = 1.;
+            } else if (d == e) {
+                fine.off[d][e] = 1.; fine.diag[d][e] = -2.; fine.end[d][e] = -2.;
+            } else {
+                fine.off[d][e] = 0.25; fine.diag[d][e] = 0.5; fine.end[d][e] = 0.5;
+            }
+        }
+    }
+    for (const int& mask : modulations) {
+        // C L C just flips the sign of the off-diagonals in modulated directions
+        MGLevelOp op = fine;
+        for (int e = 0; e < ndim; ++e)
+            if ((mask >> e) & 1)
+                for (int d = 0; d < ndim; ++d)
+                    op.off[d][e] *= -1;
+        std::vector<MGLevelOp> mod_ops;
+        mod_ops.push_back(op);
+        for (int l = 1; l < nlevels; ++l) {
+            op = CoarsenOp(op, ndim);
+            mod_ops.push_back(op);
+        }
+        ops.push_back(mod_ops);
+    }
+
+    for (int l = 0; l < nlevels; ++l) {
+        const int* n = ops[0][l].n;
+        x.push_back(ParArray4D<Real>("mg_x_" + std::to_string(l), nblocks, n[2], n[1], n[0]));
+        rhs.push_back(ParArray4D<Real>("mg_rhs_" + std::to_string(l), nblocks, n[2], n[1], n[0]));
+        res.push_back(ParArray4D<Real>("mg_res_" + std::to_string(l), nblocks, n[2], n[1], n[0]));
+    }
+    const int* n = ops[0][0].n;
+    r_in = ParArray4D<Real>("mg_r_in", nblocks, n[2], n[1], n[0]);
+    sol = ParArray4D<Real>("mg_sol", nblocks, n[2], n[1], n[0]);
+    scale = ParArray2D<Real>("mg_scale", nblocks, 3);
+}
+
+TaskStatus MGPreconditioner::Apply(MeshData<Real> *md, const std::string& in_var, MeshData<Real> *md_out, const std::string& out_var)
+{
+    const IndexRange ib = md->GetBoundsI(IndexDomain::interior);
+    const IndexRange jb = md->GetBoundsJ(IndexDomain::interior);
+    const IndexRange kb = md->GetBoundsK(IndexDomain::interior);
+
+    auto in = md->PackVariables(std::vector<std::string>{in_var});
+    auto out = md_out->PackVariables(std::vector<std::string>{out_var});
+
+    const int ndim_l = ndim;
+    const bool norm = use_normalized;
+    const MGLevelOp op0 = ops[0][0];
+    auto scale_l = scale;
+    auto r_in_l = r_in;
+    auto sol_l = sol;
+
+    parthenon::par_for(DEFAULT_LOOP_PATTERN, "mg_scale", DevExecSpace(), 0, nblocks - 1,
+        KOKKOS_LAMBDA (const int& b) {
+            const auto& G = in.GetCoords(b);
+            scale_l(b, 0) = 1. / (G.Dxc<1>(ib.s) * G.Dxc<1>(ib.s));
+            scale_l(b, 1) = 1. / (G.Dxc<2>(jb.s) * G.Dxc<2>(jb.s));
+            scale_l(b, 2) = 1. / (G.Dxc<3>(kb.s) * G.Dxc<3>(kb.s));
+        }
+    );
+
+    // Copy in the physical nodes. The normalized Laplacian is L/gdet, so its inverse is L^-1 gdet
+    parthenon::par_for(DEFAULT_LOOP_PATTERN, "mg_load", DevExecSpace(), 0, nblocks - 1,
+        0, op0.n[2] - 1, 0, op0.n[1] - 1, 0, op0.n[0] - 1,
+        KOKKOS_LAMBDA (const int& b, const int& k, const int& j, const int& i) {
+            const auto& G = in.GetCoords(b);
+            r_in_l(b, k, j, i) = in(b, 0, kb.s + k, jb.s + j, ib.s + i);
+            if (norm) r_in_l(b, k, j, i) *= G.gdet(Loci::corner, jb.s + j, ib.s + i);
+            sol_l(b, k, j, i) = 0.;
+        }
+    );
+
+    // Each V-cycle works on what the previous ones left of the residual
+    for (int q = 0; q < (int) modulations.size(); ++q) {
+        const int mask = modulations[q];
+        const bool first = (q == 0);
+        auto x0 = x[0];
+        auto rhs0 = rhs[0];
+        parthenon::par_for(DEFAULT_LOOP_PATTERN, "mg_modulate_in", DevExecSpace(), 0, nblocks - 1,
+            0, op0.n[2] - 1, 0, op0.n[1] - 1, 0, op0.n[0] - 1,
+            KOKKOS_LAMBDA (const int& b, const int& k, const int& j, const int& i) {
+                Real l1;
+                const Real Ax = (first) ? 0. : mg_apply(op0, ndim_l, scale_l, sol_l, b, k, j, i, l1);
+                rhs0(b, k, j, i) = mg_sign(mask, k, j, i) * (r_in_l(b, k, j, i) - Ax);
+                x0(b, k, j, i) = 0.;
+            }
+        );
+
+        VCycle(q, 0);
+
+        parthenon::par_for(DEFAULT_LOOP_PATTERN, "mg_modulate_out", DevExecSpace(), 0, nblocks - 1,
+            0, op0.n[2] - 1, 0, op0.n[1] - 1, 0, op0.n[0] - 1,
+            KOKKOS_LAMBDA (const int& b, const int& k, const int& j, const int& i) {
+                sol_l(b, k, j, i) += mg_sign(mask, k, j, i) * x0(b, k, j, i);
+            }
+        );
+    }
+
+    parthenon::par_for(DEFAULT_LOOP_PATTERN, "mg_store", DevExecSpace(), 0, nblocks - 1,
+        0, op0.n[2] - 1, 0, op0.n[1] - 1, 0, op0.n[0] - 1,
+        KOKKOS_LAMBDA (const int& b, const int& k, const int& j, const int& i) {
+            out(b, 0, kb.s + k, jb.s + j, ib.s + i) = sol_l(b, k, j, i);
+        }
+    );
+
+    return TaskStatus::complete;
+}
+
+void MGPreconditioner::VCycle(const int& q, const int& l)
+{
+    const MGLevelOp op = ops[q][l];
+    if (l == nlevels - 1) {
+        Smooth(l, op, ncoarse);
+        return;
+    }
+
+    Smooth(l, op, nsmooth);
+
+    const int ndim_l = ndim;
+    auto scale_l = scale;
+    auto x_l = x[l];
+    auto rhs_l = rhs[l];
+    auto res_l = res[l];
+    parthenon::par_for(DEFAULT_LOOP_PATTERN, "mg_residual", DevExecSpace(), 0, nblocks - 1,
+        0, op.n[2] - 1, 0, op.n[1] - 1, 0, op.n[0] - 1,
+        KOKKOS_LAMBDA (const int& b, const int& k, const int& j, const int& i) {
+            Real l1;
+            res_l(b, k, j, i) = rhs_l(b, k, j, i) - mg_apply(op, ndim_l, scale_l, x_l, b, k, j, i, l1);
+        }
+    );
+
+    // Restrict with the transpose of the prolongation below, to match the Galerkin coarse operator
+    const MGLevelOp opc = ops[q][l + 1];
+    auto x_c = x[l + 1];
+    auto rhs_c = rhs[l + 1];
+    parthenon::par_for(DEFAULT_LOOP_PATTERN, "mg_restrict", DevExecSpace(), 0, nblocks - 1,
+        0, opc.n[2] - 1, 0, opc.n[1] - 1, 0, opc.n[0] - 1,
+        KOKKOS_LAMBDA (const int& b, const int& k, const int& j, const int& i) {
+            const int dk_max = (ndim_l > 2), dj_max = (ndim_l > 1);
+            Real sum = 0.;
+            for (int dk = -dk_max; dk <= dk_max; ++dk) {
+                const int kf = (ndim_l > 2) ? 2*k + dk : k;
+                if (kf < 0 || kf >= op.n[2]) continue;
+                for (int dj = -dj_max; dj <= dj_max; ++dj) {
+                    const int jf = (ndim_l > 1) ? 2*j + dj : j;
+                    if (jf < 0 || jf >= op.n[1]) continue;
+                    for (int di = -1; di <= 1; ++di) {
+                        const int i_f = 2*i + di;
+                        if (i_f < 0 || i_f >= op.n[0]) continue;
+                        sum += ((dk == 0) ? 1. : 0.5) * ((dj == 0) ? 1. : 0.5) * ((di == 0) ? 1. : 0.5)
+                               * res_l(b, kf, jf, i_f);
+                    }
+                }
+            }
+            rhs_c(b, k, j, i) = sum;
+            x_c(b, k, j, i) = 0.;
+        }
+    );
+
+    VCycle(q, l + 1);
+
+    // Prolongate by (bi/tri)linear interpolation and correct
+    parthenon::par_for(DEFAULT_LOOP_PATTERN, "mg_prolongate", DevExecSpace(), 0, nblocks - 1,
+        0, op.n[2] - 1, 0, op.n[1] - 1, 0, op.n[0] - 1,
+        KOKKOS_LAMBDA (const int& b, const int& k, const int& j, const int& i) {
+            const int ip = i % 2;
+            const int jp = (ndim_l > 1) ? j % 2 : 0;
+            const int kp = (ndim_l > 2) ? k % 2 : 0;
+            const int ic = i / 2;
+            const int jc = (ndim_l > 1) ? j / 2 : j;
+            const int kc = (ndim_l > 2) ? k / 2 : k;
+            Real sum = 0.;
+            for (int c = 0; c <= kp; ++c)
+                for (int bb = 0; bb <= jp; ++bb)
+                    for (int a = 0; a <= ip; ++a)
+                        sum += x_c(b, kc + c, jc + bb, ic + a);
+            x_l(b, k, j, i) += sum / (1 << (ip + jp + kp));
+        }
+    );
+
+    Smooth(l, op, nsmooth);
+}
+
+void MGPreconditioner::Smooth(const int& l, const MGLevelOp& op, const int& iterations)
+{
+    const int ndim_l = ndim;
+    auto scale_l = scale;
+    auto x_l = x[l];
+    auto rhs_l = rhs[l];
+    auto res_l = res[l];
+    // l1-Jacobi: dividing by the l1 norm of each row rather than the diagonal converges
+    // for any of our (negative definite) operators, without tuning a weight per level
+    for (int it = 0; it < iterations; ++it) {
+        parthenon::par_for(DEFAULT_LOOP_PATTERN, "mg_smooth", DevExecSpace(), 0, nblocks - 1,
+            0, op.n[2] - 1, 0, op.n[1] - 1, 0, op.n[0] - 1,
+            KOKKOS_LAMBDA (const int& b, const int& k, const int& j, const int& i) {
+                Real l1;
+                const Real Ax = mg_apply(op, ndim_l, scale_l, x_l, b, k, j, i, l1);
+                res_l(b, k, j, i) = (rhs_l(b, k, j, i) - Ax) / l1;
+            }
+        );
+        parthenon::par_for(DEFAULT_LOOP_PATTERN, "mg_smooth_update", DevExecSpace(), 0, nblocks - 1,
+            0, op.n[2] - 1, 0, op.n[1] - 1, 0, op.n[0] - 1,
+            KOKKOS_LAMBDA (const int& b, const int& k, const int& j, const int& i) {
+                x_l(b, k, j, i) += res_l(b, k, j, i);
+            }
+        );
+    }
+}
+
+} // namespace B_Cleanup
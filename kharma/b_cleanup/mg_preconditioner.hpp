@@ -0,0 +1,159 @@
+/*
+ *  File: mg_preconditioner.hpp
+ *  
+ *  BSD 3-Clause License
+ *  
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *  
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *  
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *  
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <parthenon/parthenon.hpp>
+
+#include "decs.hpp"
+#include "types.hpp"
+
+using namespace parthenon;
+
+namespace B_Cleanup {
+
+/**
+ * Coefficients of the operator on one multigrid level.
+ *
+ * The corner Laplacian (grad to centers, div back to corners) is a sum of tensor products of
+ * 1D operators, sum_d (1/dx_d^2) prod_e T_de, where T_dd is the second difference [1 -2 1]
+ * and the other factors are the corner averaging [1/4 1/2 1/4].
+ * Galerkin coarsening (R = P^T, P linear interpolation truncated at the block edges)
+ * keeps every factor tridiagonal, with a constant off-diagonal and a constant diagonal
+ * everywhere except the two end rows. So a whole level fits in a few numbers.
+ */
+struct MGLevelOp {
+    int n[3];
+    Real off[3][3], diag[3][3], end[3][3];
+
+    KOKKOS_FORCEINLINE_FUNCTION Real factor(const int& d, const int& e, const int& idx, const int& delta) const
+    {
+        if (delta != 0) return off[d][e];
+        return (idx == 0 || idx == n[e] - 1) ? end[d][e] : diag[d][e];
+    }
+};
+
+/**
+ * Apply a level's operator at node (b,k,j,i), with zeros beyond the edges of the block.
+ * Also returns the signed l1 norm of the operator row, for use as an always-convergent
+ * Jacobi weight.
+ * scale(b,d) is 1/dx_d^2 for block b.
+ */
+template<typename Array, typename Scale>
+KOKKOS_INLINE_FUNCTION Real mg_apply(const MGLevelOp& op, const int& ndim, const Scale& scale, const Array& x,
+                                     const int& b, const int& k, const int& j, const int& i, Real& l1)
+{
+    const int idx[3] = {i, j, k};
+    const int dk_max = (ndim > 2), dj_max = (ndim > 1);
+    Real Ax = 0., center = 0.;
+    l1 = 0.;
+    for (int dk = -dk_max; dk <= dk_max; ++dk) {
+        if (k + dk < 0 || k + dk >= op.n[2]) continue;
+        for (int dj = -dj_max; dj <= dj_max; ++dj) {
+            if (j + dj < 0 || j + dj >= op.n[1]) continue;
+            for (int di = -1; di <= 1; ++di) {
+                if (i + di < 0 || i + di >= op.n[0]) continue;
+                const int delta[3] = {di, dj, dk};
+                Real c = 0.;
+                for (int d = 0; d < ndim; ++d) {
+                    Real term = scale(b, d);
+                    for (int e = 0; e < ndim; ++e)
+                        term *= op.factor(d, e, idx[e], delta[e]);
+                    c += term;
+                }
+                if (di == 0 && dj == 0 && dk == 0) center = c;
+                Ax += c * x(b, k + dk, j + dj, i + di);
+                l1 += m::abs(c);
+            }
+        }
+    }
+    if (center < 0.) l1 = -l1;
+    return Ax;
+}
+
+/**
+ * Sign of the checkerboard modulation C for node (k,j,i), see MGPreconditioner
+ */
+KOKKOS_FORCEINLINE_FUNCTION Real mg_sign(const int& mask, const int& k, const int& j, const int& i)
+{
+    const int parity = ((mask & 1) ? i : 0) + ((mask & 2) ? j : 0) + ((mask & 4) ? k : 0);
+    return (parity % 2) ? -1. : 1.;
+}
+
+/**
+ * Block-local geometric multigrid preconditioner for the corner Laplacian in B_Cleanup.
+ *
+ * Each meshblock's nodes are coarsened by factors of 2 as far as the block size allows,
+ * and M^-1 r is approximated by V-cycles with l1-Jacobi smoothing, with zero correction
+ * assumed past the block edges (i.e., block Jacobi between meshblocks).
+ * The corner Laplacian decouples checkerboard-like modes in two or more directions,
+ * which look like high-frequency noise to the plain V-cycle but carry small eigenvalues.
+ * So we additionally run a V-cycle for each such "modulated" operator C L C,
+ * C = (-1)^(sum of indices over the modulated directions), each against the remaining residual.
+ *
+ * This is a fixed linear operator, and so is safe to use as a right-preconditioner in BiCGStab.
+ */
+class MGPreconditioner {
+    public:
+        MGPreconditioner(MeshData<Real> *md, const int& max_levels, const int& smooth_iterations,
+                         const int& coarse_iterations, const bool& use_normalized);
+
+        /**
+         * Set out_var = M^-1 in_var on the physical nodes.  Matches BiCGStabSolver::FMatVec.
+         */
+        TaskStatus Apply(MeshData<Real> *md, const std::string& in_var, MeshData<Real> *md_out, const std::string& out_var);
+
+        int NumLevels() const { return nlevels; }
+
+    private:
+        void VCycle(const int& q, const int& l);
+        void Smooth(const int& l, const MGLevelOp& op, const int& iterations);
+
+        int ndim, nblocks, nlevels, nsmooth, ncoarse;
+        bool use_normalized;
+        // Directions in which each V-cycle's operator is modulated, as bitmasks
+        std::vector<int> modulations;
+        // Operator coefficients, by modulation and level
+        std::vector<std::vector<MGLevelOp>> ops;
+        // Correction, RHS and residual by level
+        std::vector<ParArray4D<Real>> x, rhs, res;
+        // Input and accumulated result, on the finest level
+        ParArray4D<Real> r_in, sol;
+        // 1/dx^2 by block and direction
+        ParArray2D<Real> scale;
+};
+
+} // namespace B_Cleanup
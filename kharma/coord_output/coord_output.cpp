@@ -150,7 +150,9 @@ TaskStatus CoordinateOutput::BlockUserWorkBeforeOutput(MeshBlock *pmb, Parameter
                 Geom(mlapse, k, j, i) = 1. / m::sqrt(-G.gcon(Loci::center, j, i, 0, 0));
                 // shift? = G.gcon(Loci::center, j, i, 0, 1) * alpha * alpha;
                 // Connection
-                DLOOP3 Geom(mconn+GR_DIM*GR_DIM*mu+GR_DIM*nu+lam, k, j, i) = G.conn(j, i, mu, nu, lam);
+                Real conn[GR_DIM][GR_DIM][GR_DIM];
+                G.conn(j, i, conn);
+                DLOOP3 Geom(mconn+GR_DIM*GR_DIM*mu+GR_DIM*nu+lam, k, j, i) = conn[mu][nu][lam];
 
             }
         );
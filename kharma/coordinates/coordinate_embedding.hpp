@@ -72,6 +72,8 @@
  * * coord_to_native
  * * dxdX_to_embed
  * * dxdX_to_native
+ * Optionally, the base may implement conn_embed and the transform d2xdX2, in which case
+ * the connection is computed in closed form rather than by finite differences of the metric.
  * 
  * Each possible class is added to a couple of mpark::variant containers, and then to the chains of if statements below.
  *
@@ -502,7 +504,133 @@ class CoordinateEmbedding {
             return gcon_native(gcov, gcon);
         }
 
+        // Single-component generators, for evaluating the metric on the fly rather than caching it.
+        // These avoid the full 4x4 transform (and for KS, any inversion) when only one component is needed
+        KOKKOS_INLINE_FUNCTION Real gcov_native(const GReal Xnative[GR_DIM], const int mu, const int nu) const
+        {
+            GReal Xembed[GR_DIM];
+            Real gcov_em[GR_DIM][GR_DIM], dxdX_temp[GR_DIM][GR_DIM];
+            coord_to_embed(Xnative, Xembed);
+            gcov_embed(Xembed, gcov_em);
+            dxdX(Xnative, dxdX_temp);
+
+            Real gcov = 0.;
+            for (int lam = 0; lam < GR_DIM; ++lam)
+                for (int kap = 0; kap < GR_DIM; ++kap)
+                    gcov += gcov_em[lam][kap]*dxdX_temp[lam][mu]*dxdX_temp[kap][nu];
+            return gcov;
+        }
+        KOKKOS_INLINE_FUNCTION Real gcon_native(const GReal Xnative[GR_DIM], const int mu, const int nu) const
+        {
+            if (mpark::holds_alternative<SphKSCoords>(base)) {
+                GReal Xembed[GR_DIM];
+                Real gcon_em[GR_DIM][GR_DIM], dXdx_temp[GR_DIM][GR_DIM];
+                coord_to_embed(Xnative, Xembed);
+                mpark::get<SphKSCoords>(base).gcon_embed(Xembed, gcon_em);
+                dXdx(Xnative, dXdx_temp);
+
+                Real gcon = 0.;
+                for (int lam = 0; lam < GR_DIM; ++lam)
+                    for (int kap = 0; kap < GR_DIM; ++kap)
+                        gcon += gcon_em[lam][kap]*dXdx_temp[mu][lam]*dXdx_temp[nu][kap];
+                return gcon;
+            } else {
+                Real gcon[GR_DIM][GR_DIM];
+                gcon_native(Xnative, gcon);
+                return gcon[mu][nu];
+            }
+        }
+        KOKKOS_INLINE_FUNCTION Real gdet_native_fast(const GReal Xnative[GR_DIM]) const
+        {
+            if (mpark::holds_alternative<SphKSCoords>(base)) {
+                GReal Xembed[GR_DIM];
+                Real dxdX_temp[GR_DIM][GR_DIM];
+                coord_to_embed(Xnative, Xembed);
+                dxdX(Xnative, dxdX_temp);
+                return mpark::get<SphKSCoords>(base).gdet_embed(Xembed) * m::abs(determinant(&dxdX_temp[0][0]));
+            } else {
+                return gdet_native(Xnative);
+            }
+        }
+
+        /**
+         * Whether the connection can be computed in closed form, i.e. whether the base system provides conn_embed
+         * and the transform provides d2xdX2.
+         */
+        KOKKOS_INLINE_FUNCTION bool has_analytic_conn() const
+        {
+            return mpark::holds_alternative<SphKSCoords>(base) &&
+                   (mpark::holds_alternative<NullTransform>(transform) ||
+                    mpark::holds_alternative<SphNullTransform>(transform) ||
+                    mpark::holds_alternative<ExponentialTransform>(transform) ||
+                    mpark::holds_alternative<ModifyTransform>(transform) ||
+                    mpark::holds_alternative<FunkyTransform>(transform));
+        }
+
+        /**
+         * Connection coefficients \Gamma^lam_{nu mu} in native coordinates.
+         * Uses the closed form if available, otherwise falls back to finite differences of the metric with step delta
+         */
         KOKKOS_INLINE_FUNCTION void conn_native(const GReal X[GR_DIM], const GReal delta, Real conn[GR_DIM][GR_DIM][GR_DIM]) const
+        {
+            if (has_analytic_conn()) {
+                conn_native_analytic(X, conn);
+            } else {
+                conn_native_numerical(X, delta, conn);
+            }
+        }
+
+        /**
+         * Transform the connection from the embedding system:
+         * \Gamma^lam_{nu mu} = dX^lam/dx^a (\Gamma^a_{b c} dx^b/dX^nu dx^c/dX^mu + d^2x^a / dX^nu dX^mu)
+         */
+        KOKKOS_INLINE_FUNCTION void conn_native_analytic(const GReal X[GR_DIM], Real conn[GR_DIM][GR_DIM][GR_DIM]) const
+        {
+            GReal Xembed[GR_DIM];
+            coord_to_embed(X, Xembed);
+
+            Real conn_em[GR_DIM][GR_DIM][GR_DIM];
+            if (mpark::holds_alternative<SphKSCoords>(base)) {
+                mpark::get<SphKSCoords>(base).conn_embed(Xembed, conn_em);
+            }
+
+            Real d2xdX2[GR_DIM][GR_DIM][GR_DIM];
+            if (mpark::holds_alternative<NullTransform>(transform)) {
+                mpark::get<NullTransform>(transform).d2xdX2(X, d2xdX2);
+            } else if (mpark::holds_alternative<SphNullTransform>(transform)) {
+                mpark::get<SphNullTransform>(transform).d2xdX2(X, d2xdX2);
+            } else if (mpark::holds_alternative<ExponentialTransform>(transform)) {
+                mpark::get<ExponentialTransform>(transform).d2xdX2(X, d2xdX2);
+            } else if (mpark::holds_alternative<ModifyTransform>(transform)) {
+                mpark::get<ModifyTransform>(transform).d2xdX2(X, d2xdX2);
+            } else if (mpark::holds_alternative<FunkyTransform>(transform)) {
+                mpark::get<FunkyTransform>(transform).d2xdX2(X, d2xdX2);
+            }
+
+            Real dxdX_temp[GR_DIM][GR_DIM], dXdx_temp[GR_DIM][GR_DIM];
+            dxdX(X, dxdX_temp);
+            dXdx(X, dXdx_temp);
+
+            // Contract one lower index at a time, then add the inhomogeneous term
+            Real tmp[GR_DIM][GR_DIM][GR_DIM];
+            DLOOP3 {
+                tmp[mu][nu][lam] = 0.;
+                for (int kap = 0; kap < GR_DIM; ++kap)
+                    tmp[mu][nu][lam] += conn_em[mu][nu][kap] * dxdX_temp[kap][lam];
+            }
+            DLOOP3 {
+                conn_em[mu][nu][lam] = d2xdX2[mu][nu][lam];
+                for (int kap = 0; kap < GR_DIM; ++kap)
+                    conn_em[mu][nu][lam] += dxdX_temp[kap][nu] * tmp[mu][kap][lam];
+            }
+            DLOOP3 {
+                conn[mu][nu][lam] = 0.;
+                for (int kap = 0; kap < GR_DIM; ++kap)
+                    conn[mu][nu][lam] += dXdx_temp[mu][kap] * conn_em[kap][nu][lam];
+            }
+        }
+
+        KOKKOS_INLINE_FUNCTION void conn_native_numerical(const GReal X[GR_DIM], const GReal delta, Real conn[GR_DIM][GR_DIM][GR_DIM]) const
         {
             GReal tmp[GR_DIM][GR_DIM][GR_DIM];
             GReal gcon[GR_DIM][GR_DIM];
@@ -150,6 +150,88 @@ class SphKSCoords {
             gcov[3][3] = sin2*(rho2 + a*a*sin2*(1. + 2.*r/rho2));
         }
 
+        // Closed forms of the inverse metric and determinant, so neither requires a matrix inversion
+        KOKKOS_INLINE_FUNCTION void gcon_embed(const GReal Xembed[GR_DIM], Real gcon[GR_DIM][GR_DIM]) const
+        {
+            const GReal r = Xembed[1];
+            const GReal th = excise(excise(Xembed[2], 0.0, SMALL), M_PI, SMALL);
+
+            const GReal cth = m::cos(th);
+            const GReal sth = m::sin(th);
+            const GReal rho2 = r*r + a*a*cth*cth;
+
+            gzero2(gcon);
+            gcon[0][0] = -1. - 2.*r/rho2;
+            gcon[0][1] = 2.*r/rho2;
+            gcon[1][0] = 2.*r/rho2;
+            gcon[1][1] = (r*r - 2.*r + a*a)/rho2;
+            gcon[1][3] = a/rho2;
+            gcon[3][1] = a/rho2;
+            gcon[2][2] = 1./rho2;
+            gcon[3][3] = 1./(rho2*sth*sth);
+        }
+        KOKKOS_INLINE_FUNCTION Real gdet_embed(const GReal Xembed[GR_DIM]) const
+        {
+            const GReal r = Xembed[1];
+            const GReal th = excise(excise(Xembed[2], 0.0, SMALL), M_PI, SMALL);
+            const GReal cth = m::cos(th);
+            return (r*r + a*a*cth*cth)*m::abs(m::sin(th));
+        }
+
+        /**
+         * Connection coefficients \Gamma^lam_{mu nu} in KS coordinates, from closed-form derivatives of the metric above.
+         * The metric depends only on r and th, so at most two of the derivative slices are nonzero,
+         * and the inverse metric is known analytically.
+         */
+        KOKKOS_INLINE_FUNCTION void conn_embed(const GReal Xembed[GR_DIM], Real conn[GR_DIM][GR_DIM][GR_DIM]) const
+        {
+            const GReal r = Xembed[1];
+            const GReal th = excise(excise(Xembed[2], 0.0, SMALL), M_PI, SMALL);
+
+            const GReal cth = m::cos(th);
+            const GReal sth = m::sin(th);
+            const GReal sin2 = sth*sth;
+            const GReal rho2 = r*r + a*a*cth*cth;
+            const GReal f = 2.*r/rho2;
+
+            // Derivatives of the building blocks w.r.t. r (index 1) and th (index 2)
+            const GReal drho2[3] = {0., 2.*r, -2.*a*a*cth*sth};
+            const GReal dsin2[3] = {0., 0., 2.*sth*cth};
+            GReal df[3];
+            df[0] = 0.;
+            df[1] = 2./rho2 - f*drho2[1]/rho2;
+            df[2] = -f*drho2[2]/rho2;
+
+            // dg[lam][mu][nu] = \partial_lam g_{mu nu}
+            Real dg[GR_DIM][GR_DIM][GR_DIM];
+            DLOOP3 dg[mu][nu][lam] = 0.;
+            for (int d = 1; d < 3; ++d) {
+                dg[d][0][0] = df[d];
+                dg[d][0][1] = df[d];
+                dg[d][0][3] = -a*(df[d]*sin2 + f*dsin2[d]);
+                dg[d][1][1] = df[d];
+                dg[d][1][3] = -a*(dsin2[d]*(1. + f) + sin2*df[d]);
+                dg[d][2][2] = drho2[d];
+                dg[d][3][3] = dsin2[d]*(rho2 + a*a*sin2*(1. + f))
+                              + sin2*(drho2[d] + a*a*(dsin2[d]*(1. + f) + sin2*df[d]));
+                dg[d][1][0] = dg[d][0][1];
+                dg[d][3][0] = dg[d][0][3];
+                dg[d][3][1] = dg[d][1][3];
+            }
+
+            Real gcon[GR_DIM][GR_DIM];
+            gcon_embed(Xembed, gcon);
+
+            // \Gamma_{kap mu nu}, then raise the first index
+            Real tmp[GR_DIM][GR_DIM][GR_DIM];
+            DLOOP3 tmp[lam][mu][nu] = 0.5*(dg[nu][lam][mu] + dg[mu][lam][nu] - dg[lam][mu][nu]);
+            DLOOP3 {
+                conn[lam][mu][nu] = 0.;
+                for (int kap = 0; kap < GR_DIM; ++kap)
+                    conn[lam][mu][nu] += gcon[lam][kap]*tmp[kap][mu][nu];
+            }
+        }
+
         // For converting from BL
         KOKKOS_INLINE_FUNCTION void vec_from_bl(const GReal Xembed[GR_DIM], const Real vcon_bl[GR_DIM], Real vcon[GR_DIM]) const
         {
@@ -343,6 +425,8 @@ class SphBLExtG {
  * Each class must define enough functions to apply the transform to coordinates and vectors,
  * both forward and in reverse.
  * That comes out to 4 functions: coord_to_embed, coord_to_native, dXdx, dxdX
+ * Transforms may additionally define d2xdX2, the second derivatives of the embedding coordinates,
+ * which allows computing the connection analytically (see CoordinateEmbedding::conn_native)
  */
 
 /**
@@ -372,6 +456,10 @@ class NullTransform {
         {
             DLOOP2 dXdx[mu][nu] = (mu == nu);
         }
+        KOKKOS_INLINE_FUNCTION void d2xdX2(const GReal X[GR_DIM], Real d2xdX2[GR_DIM][GR_DIM][GR_DIM]) const
+        {
+            DLOOP3 d2xdX2[mu][nu][lam] = 0.;
+        }
 };
 // This only exists separately to define startx & stopx. Could fall back on base coords for these?
 class SphNullTransform {
@@ -398,6 +486,10 @@ class SphNullTransform {
         {
             DLOOP2 dXdx[mu][nu] = (mu == nu);
         }
+        KOKKOS_INLINE_FUNCTION void d2xdX2(const GReal X[GR_DIM], Real d2xdX2[GR_DIM][GR_DIM][GR_DIM]) const
+        {
+            DLOOP3 d2xdX2[mu][nu][lam] = 0.;
+        }
 };
 
 /**
@@ -451,6 +543,14 @@ class ExponentialTransform {
             dXdx[2][2] = 1.;
             dXdx[3][3] = 1.;
         }
+        /**
+         * Second derivatives d^2 x^mu / dX^nu dX^lam
+         */
+        KOKKOS_INLINE_FUNCTION void d2xdX2(const GReal Xnative[GR_DIM], Real d2xdX2[GR_DIM][GR_DIM][GR_DIM]) const
+        {
+            DLOOP3 d2xdX2[mu][nu][lam] = 0.;
+            d2xdX2[1][1][1] = m::exp(Xnative[1]);
+        }
 };
 
 /**
@@ -577,6 +677,15 @@ class ModifyTransform {
             dXdx[2][2] = 1 / (M_PI - (hslope - 1.)*M_PI*m::cos(2.*M_PI*Xnative[2]));
             dXdx[3][3] = 1.;
         }
+        /**
+         * Second derivatives d^2 x^mu / dX^nu dX^lam
+         */
+        KOKKOS_INLINE_FUNCTION void d2xdX2(const GReal Xnative[GR_DIM], Real d2xdX2[GR_DIM][GR_DIM][GR_DIM]) const
+        {
+            DLOOP3 d2xdX2[mu][nu][lam] = 0.;
+            d2xdX2[1][1][1] = m::exp(Xnative[1]);
+            d2xdX2[2][2][2] = -2.*M_PI*M_PI*(1. - hslope)*m::sin(2.*M_PI*Xnative[2]);
+        }
 };
 
 /**
@@ -664,6 +773,31 @@ class FunkyTransform {
             dxdX(Xnative, dxdX_tmp);
             invert(&dxdX_tmp[0][0],&dXdx[0][0]);
         }
+        /**
+         * Second derivatives d^2 x^mu / dX^nu dX^lam
+         * With E = exp(mks_smooth*(startx1 - X1)), th = thG + E*(thJ - thG), and the X2 derivatives of
+         * thG and thJ are simple closed forms
+         */
+        KOKKOS_INLINE_FUNCTION void d2xdX2(const GReal Xnative[GR_DIM], Real d2xdX2[GR_DIM][GR_DIM][GR_DIM]) const
+        {
+            const GReal E = m::exp(mks_smooth * (startx1 - Xnative[1]));
+
+            const GReal thG = M_PI*Xnative[2] + ((1. - hslope)/2.)*m::sin(2.*M_PI*Xnative[2]);
+            const GReal dthG = M_PI + (1. - hslope)*M_PI*m::cos(2.*M_PI*Xnative[2]);
+            const GReal d2thG = -2.*M_PI*M_PI*(1. - hslope)*m::sin(2.*M_PI*Xnative[2]);
+
+            const GReal y = 2*Xnative[2] - 1.;
+            const GReal thJ = poly_norm * y * (1. + m::pow(y/poly_xt,poly_alpha) / (poly_alpha + 1.)) + 0.5 * M_PI;
+            const GReal dthJ = 2. * poly_norm * (1. + m::pow(y/poly_xt, poly_alpha));
+            const GReal d2thJ = 4. * poly_norm * poly_alpha / poly_xt * m::pow(y/poly_xt, poly_alpha - 1.);
+
+            DLOOP3 d2xdX2[mu][nu][lam] = 0.;
+            d2xdX2[1][1][1] = m::exp(Xnative[1]);
+            d2xdX2[2][1][1] = mks_smooth * mks_smooth * E * (thJ - thG);
+            d2xdX2[2][1][2] = -mks_smooth * E * (dthJ - dthG);
+            d2xdX2[2][2][1] = d2xdX2[2][1][2];
+            d2xdX2[2][2][2] = d2thG + E * (d2thJ - d2thG);
+        }
 };
 
 // Bundle coordinates and transforms into umbrella variant types
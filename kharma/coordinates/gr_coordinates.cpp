@@ -38,6 +38,10 @@
 
 #include "gr_coordinates.hpp"
 
+#include <map>
+#include <set>
+#include <tuple>
+
 // This needs to be included only here -- it requires full-formed Parthenon
 // types, which are not available when importing this file's header
 #include "types.hpp"
@@ -45,15 +49,14 @@
 using Kokkos::MDRangePolicy;
 using Kokkos::Rank;
 
-// Stepsize for numerical derivatives of the metric
-#define DELTA 1.e-8
-
 #if FAST_CARTESIAN
 /**
  * Fast Cartesian GRCoordinates objects just use the underlying UniformCartesian object for everything
  */
 GRCoordinates::GRCoordinates(const RegionSize &rs, ParameterInput *pin): UniformCartesian(rs, pin) {}
 GRCoordinates::GRCoordinates(const GRCoordinates &src, int coarsen): UniformCartesian(src, coarsen) {}
+void GRCoordinates::PruneSharedGeometry(const std::vector<GRCoordinates>& in_use) {}
+void GRCoordinates::ClearSharedGeometry() {}
 #else
 // Internal function for initializing cache
 void init_GRCoordinates(GRCoordinates& G);
@@ -72,6 +75,11 @@ GRCoordinates::GRCoordinates(const RegionSize &rs, ParameterInput *pin): Uniform
 
     connection_average_points = pin->GetOrAddInteger("coordinates", "connection_average_points", 1);
     correct_connections = pin->GetOrAddBoolean("coordinates", "correct_connections", false);
+    share_geometry = pin->GetOrAddBoolean("coordinates", "share_geometry", true);
+    // Evaluate the metric on the fly instead of caching it.  Saves memory, costs compute
+    cache_geometry = pin->GetOrAddBoolean("coordinates", "cache_geometry", true);
+    if (!cache_geometry && (correct_connections || connection_average_points > 1))
+        throw std::invalid_argument("Connection averaging & correction require cache_geometry=true!");
 
     init_GRCoordinates(*this);
 }
@@ -79,12 +87,51 @@ GRCoordinates::GRCoordinates(const RegionSize &rs, ParameterInput *pin): Uniform
 GRCoordinates::GRCoordinates(const GRCoordinates &src, int coarsen): UniformCartesian(src, coarsen),
     coords(src.coords), n1(src.n1/coarsen), n2(src.n2/coarsen), n3(src.n3/coarsen),
     connection_average_points(src.connection_average_points),
-    correct_connections(src.correct_connections)
+    correct_connections(src.correct_connections), share_geometry(src.share_geometry),
+    cache_geometry(src.cache_geometry)
 {
     //std::cerr << "Calling coarsen constructor" << std::endl;
     init_GRCoordinates(*this);
 }
 
+/**
+ * Registry of geometry caches on this rank, so that blocks covering the same (X1,X2) region
+ * at the same resolution can share them.  Each entry is just another reference to the
+ * (reference-counted) cache arrays, which are freed when neither blocks nor the registry use them.
+ * The key is (n1, n2, X1 extent, X2 extent), all including ghost zones.  Since the caches are
+ * only ever computed with k=0, any two blocks matching this key would compute identical values.
+ */
+struct SharedGeometry {
+    GeomTensor2 gcon, gcov;
+    GeomScalar gdet;
+    GeomTensor3 conn, gdet_conn;
+};
+using SharedGeometryKey = std::tuple<int, int, GReal, GReal, GReal, GReal>;
+static std::map<SharedGeometryKey, SharedGeometry> shared_geometry;
+
+SharedGeometryKey shared_geometry_key(const GRCoordinates& G)
+{
+    return std::make_tuple(G.n1, G.n2, G.Xf<1>(0), G.Xf<1>(G.n1), G.Xf<2>(0), G.Xf<2>(G.n2));
+}
+
+void GRCoordinates::PruneSharedGeometry(const std::vector<GRCoordinates>& in_use)
+{
+    std::set<SharedGeometryKey> keys;
+    for (auto& G : in_use) keys.insert(shared_geometry_key(G));
+    for (auto it = shared_geometry.begin(); it != shared_geometry.end();) {
+        if (!keys.count(it->first)) {
+            it = shared_geometry.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void GRCoordinates::ClearSharedGeometry()
+{
+    shared_geometry.clear();
+}
+
 /**
  * Initialize any cached geometry that GRCoordinates will need to return. While
  * GRCoordinates objects will be moved device-side, this can be run only on the
@@ -100,13 +147,29 @@ void init_GRCoordinates(GRCoordinates& G) {
     const bool correct_connections = G.correct_connections;
     const int connection_average_points = G.connection_average_points;
 
+    // Nothing to do if we're computing the geometry on the fly
+    if (!G.cache_geometry) return;
+
+    // Use an existing cache if another block has already computed it
+    const SharedGeometryKey key = shared_geometry_key(G);
+    if (G.share_geometry && shared_geometry.count(key)) {
+        const SharedGeometry& geom = shared_geometry.at(key);
+        G.gcon_direct = geom.gcon;
+        G.gcov_direct = geom.gcov;
+        G.gdet_direct = geom.gdet;
+        G.conn_direct = geom.conn;
+        G.gdet_conn_direct = geom.gdet_conn;
+        return;
+    }
+
     //cerr << "Creating GRCoordinate cache size " << n1 << " " << n2 << std::endl;
     // Cache geometry.  May be faster than re-computing. May not be.
-    G.gcon_direct = GeomTensor2("gcon", NLOC, n2+1, n1+1, GR_DIM, GR_DIM);
-    G.gcov_direct = GeomTensor2("gcov", NLOC, n2+1, n1+1, GR_DIM, GR_DIM);
+    // Symmetric indices are packed, see sym_idx in decs.hpp
+    G.gcon_direct = GeomTensor2("gcon", NLOC, n2+1, n1+1, GR_DIM_SYM);
+    G.gcov_direct = GeomTensor2("gcov", NLOC, n2+1, n1+1, GR_DIM_SYM);
     G.gdet_direct = GeomScalar("gdet", NLOC, n2+1, n1+1);
-    G.conn_direct = GeomTensor3("conn", n2, n1, GR_DIM, GR_DIM, GR_DIM);
-    G.gdet_conn_direct = GeomTensor3("conn", n2, n1, GR_DIM, GR_DIM, GR_DIM);
+    G.conn_direct = GeomTensor3("conn", n2, n1, GR_DIM, GR_DIM_SYM);
+    G.gdet_conn_direct = GeomTensor3("conn", n2, n1, GR_DIM, GR_DIM_SYM);
 
     // Member variables have an implicit this->
     // C++ Lambdas (and therefore Kokkos Lambdas) capture pointers to objects, not full objects
@@ -148,17 +211,18 @@ void init_GRCoordinates(GRCoordinates& G) {
                             const GReal gdet = G.coords.gcon_native(gcov_loc, gcon_loc);
                             // Add to running averages
                             gdet_local(loc, j, i) += gdet / square;
-                            DLOOP2 {
-                                gcov_local(loc, j, i, mu, nu) += gcov_loc[mu][nu] / square;
-                                gcon_local(loc, j, i, mu, nu) += gcon_loc[mu][nu] / square;
+                            DLOOP2S {
+                                gcov_local(loc, j, i, sym_idx(mu, nu)) += gcov_loc[mu][nu] / square;
+                                gcon_local(loc, j, i, sym_idx(mu, nu)) += gcon_loc[mu][nu] / square;
                             }
                             if (loc == Loci::center) {
                                 // In the center, get the connection and gdet*connection
+                                // (analytic where available, see CoordinateEmbedding::has_analytic_conn)
                                 Real conn_loc[GR_DIM][GR_DIM][GR_DIM];
-                                G.coords.conn_native(X, DELTA, conn_loc);
-                                DLOOP3 {
-                                    conn_local(j, i, mu, nu, lam) += conn_loc[mu][nu][lam] / square;
-                                    gdet_conn_local(j, i, mu, nu, lam) += gdet*conn_loc[mu][nu][lam] / square;
+                                G.coords.conn_native(X, CONN_DELTA, conn_loc);
+                                DLOOP3S {
+                                    conn_local(j, i, mu, sym_idx(nu, lam)) += conn_loc[mu][nu][lam] / square;
+                                    gdet_conn_local(j, i, mu, sym_idx(nu, lam)) += gdet*conn_loc[mu][nu][lam] / square;
                                 }
                             }
                         }
@@ -180,9 +244,9 @@ void init_GRCoordinates(GRCoordinates& G) {
                         const GReal gdet = G.coords.gcon_native(gcov_loc, gcon_loc);
                         // Add to running averages
                         gdet_local(loc, j, i) += gdet / diameter;
-                        DLOOP2 {
-                            gcov_local(loc, j, i, mu, nu) += gcov_loc[mu][nu] / diameter;
-                            gcon_local(loc, j, i, mu, nu) += gcon_loc[mu][nu] / diameter;
+                        DLOOP2S {
+                            gcov_local(loc, j, i, sym_idx(mu, nu)) += gcov_loc[mu][nu] / diameter;
+                            gcon_local(loc, j, i, sym_idx(mu, nu)) += gcon_loc[mu][nu] / diameter;
                         }
                     }
                 } else { // corner
@@ -195,9 +259,9 @@ void init_GRCoordinates(GRCoordinates& G) {
                     const GReal gdet = G.coords.gcon_native(gcov_loc, gcon_loc);
                     // Set geometry
                     gdet_local(loc, j, i) = gdet;
-                    DLOOP2 {
-                        gcov_local(loc, j, i, mu, nu) = gcov_loc[mu][nu];
-                        gcon_local(loc, j, i, mu, nu) = gcon_loc[mu][nu];
+                    DLOOP2S {
+                        gcov_local(loc, j, i, sym_idx(mu, nu)) = gcov_loc[mu][nu];
+                        gcon_local(loc, j, i, sym_idx(mu, nu)) = gcon_loc[mu][nu];
                     }
                 }
             }
@@ -227,8 +291,8 @@ void init_GRCoordinates(GRCoordinates& G) {
                         GReal test_sum = 0;
                         GReal sum_portions, portions[GR_DIM] = {0};
                         DLOOP1 {
-                            test_sum += gdet_conn_local(j, i, mu, mu, lam);
-                            portions[mu] = m::abs(gdet_conn_local(j, i, mu, mu, lam));
+                            test_sum += gdet_conn_local(j, i, mu, sym_idx(mu, lam));
+                            portions[mu] = m::abs(gdet_conn_local(j, i, mu, sym_idx(mu, lam)));
                             sum_portions += portions[mu];
                         }
                         DLOOP1 portions[mu] /= sum_portions;
@@ -236,14 +300,18 @@ void init_GRCoordinates(GRCoordinates& G) {
 
                         // Add the difference among components equally
                         const GReal diff = test_sum - target;
-                        DLOOP1 gdet_conn_local(j, i, mu, mu, lam) = gdet_conn_local(j, i, mu, mu, lam) - diff*portions[mu];
-
-                        // This is separated and set equal, as there will be one self-assignment
-                        DLOOP1 gdet_conn_local(j, i, mu, lam, mu) = gdet_conn_local(j, i, mu, mu, lam);
+                        // Packed storage means this also sets the symmetric component (mu, lam, mu)
+                        DLOOP1 gdet_conn_local(j, i, mu, sym_idx(mu, lam)) = gdet_conn_local(j, i, mu, sym_idx(mu, lam)) - diff*portions[mu];
                     }
                 }
             }
         );
     }
+
+    // Register the new cache for use by later blocks
+    if (G.share_geometry) {
+        shared_geometry[key] = SharedGeometry{G.gcon_direct, G.gcov_direct, G.gdet_direct,
+                                              G.conn_direct, G.gdet_conn_direct};
+    }
 }
 #endif // FAST_CARTESIAN
@@ -49,11 +49,15 @@
 // This import should always be okay, too
 #include "Kokkos_Core.hpp"
 
+#include <vector>
+
 // Option to ignore coordinates entirely,
 // and only use flat-space SR in Cartesian coordinates
 #define FAST_CARTESIAN 0
-// Don't cache values of the metric, etc, just call into CoordinateEmbedding directly
-#define NO_CACHE 0
+
+// Stepsize for numerical derivatives of the metric, when the connection has no closed form.
+// Shared by the cached and on-the-fly connections (plain DELTA is taken by the inverter)
+#define CONN_DELTA 1.e-8
 
 /**
  * Replacement/extension coordinate class for Parthenon
@@ -82,8 +86,17 @@ public:
     // metric determinant derivatives discretized at faces
     bool correct_connections = false;
 
+    // Whether to share geometry caches with other blocks on this rank covering the same (X1,X2) region.
+    // The caches are 2D, so e.g. blocks differing only in X3 would otherwise hold identical copies
+    bool share_geometry = true;
+
+    // Whether to cache the geometry at all.  If false, each access re-computes just the requested
+    // component from the CoordinateEmbedding, trading FLOPs for memory bandwidth & footprint
+    bool cache_geometry = true;
+
     // Caches for geometry values at zone centers/faces/etc
-#if !FAST_CARTESIAN && !NO_CACHE
+    // Symmetric indices are packed: use the accessors below rather than these directly
+#if !FAST_CARTESIAN
     GeomTensor2 gcon_direct, gcov_direct;
     GeomScalar gdet_direct;
     GeomTensor3 conn_direct, gdet_conn_direct;
@@ -102,10 +115,11 @@ public:
     KOKKOS_FUNCTION GRCoordinates(const GRCoordinates &src): UniformCartesian(src),
         n1(src.n1), n2(src.n2), n3(src.n3), coords(src.coords),
         connection_average_points(src.connection_average_points),
-        correct_connections(src.correct_connections)
+        correct_connections(src.correct_connections), share_geometry(src.share_geometry),
+        cache_geometry(src.cache_geometry)
     {
         //std::cerr << "Calling copy constructor size " << src.n1 << " " << src.n2 << std::endl;
-#if !FAST_CARTESIAN && !NO_CACHE
+#if !FAST_CARTESIAN
         gcon_direct = src.gcon_direct;
         gcov_direct = src.gcov_direct;
         gdet_direct = src.gdet_direct;
@@ -125,7 +139,9 @@ public:
         n3 = src.n3;
         connection_average_points = src.connection_average_points;
         correct_connections = src.correct_connections;
-#if !FAST_CARTESIAN && !NO_CACHE
+        share_geometry = src.share_geometry;
+        cache_geometry = src.cache_geometry;
+#if !FAST_CARTESIAN
         gcon_direct = src.gcon_direct;
         gcov_direct = src.gcov_direct;
         gdet_direct = src.gdet_direct;
@@ -135,6 +151,16 @@ public:
         return *this;
     };
 
+    /**
+     * Drop this rank's references to any shared geometry caches not used by a GRCoordinates object in 'in_use'.
+     * Memory is freed once no block holds the caches either, e.g. after AMR or load balancing
+     */
+    static void PruneSharedGeometry(const std::vector<GRCoordinates>& in_use);
+    /**
+     * Drop all references held by the shared geometry registry.  Must be called before Kokkos is finalized
+     */
+    static void ClearSharedGeometry();
+
     // Correct the coordinate system name for outputs.
     // So far the only override we need.
     const char *Name() const {
@@ -227,10 +253,10 @@ KOKKOS_INLINE_FUNCTION void GRCoordinates::raise(const Real vcov[GR_DIM], Real v
     DLOOP2 vcon[mu] += gcon(loc, j, i, mu, nu) * vcov[nu];
 }
 
-// Three different implementations of the metric functions:
+// Two different implementations of the metric functions, plus a runtime switch:
 // FAST_CARTESIAN: Minkowski space constant values
-// NO_CACHE: Re-calculate from coordinates object on every access
-// NORMAL: Cache each zone center and return cached value thereafter
+// NORMAL: Cache each zone center and return cached value thereafter,
+//         or if !cache_geometry, re-calculate the requested component from the coordinates object on every access
 #if FAST_CARTESIAN
 KOKKOS_INLINE_FUNCTION Real GRCoordinates::gcon(const Loci loc, const int& j, const int& i, const int mu, const int nu) const
 { return -2*(mu == 0 && nu == 0) + (mu == nu); }
@@ -251,75 +277,84 @@ KOKKOS_INLINE_FUNCTION void GRCoordinates::conn(const int& j, const int& i, Real
 {DLOOP3 conn[mu][nu][lam] = 0;}
 KOKKOS_INLINE_FUNCTION void GRCoordinates::gdet_conn(const int& j, const int& i, Real gdet_conn[GR_DIM][GR_DIM][GR_DIM]) const
 {DLOOP3 gdet_conn[mu][nu][lam] = 0;}
-#elif NO_CACHE
-// TODO these are currently VERY SLOW.  Rework them to generate just the desired component. (TODO gdet?...)
-// Except conn.  We never need conn fast.
+#else
 KOKKOS_INLINE_FUNCTION Real GRCoordinates::gcon(const Loci loc, const int& j, const int& i, const int mu, const int nu) const
 {
-    GReal X[GR_DIM], gcon[GR_DIM][GR_DIM];
+    if (cache_geometry) return gcon_direct(loc, j, i, sym_idx(mu, nu));
+    GReal X[GR_DIM];
     coord(0, j, i, loc, X);
-    coords.gcon_native(X, gcon);
-    return gcon[mu][nu];
+    return coords.gcon_native(X, mu, nu);
 }
 KOKKOS_INLINE_FUNCTION Real GRCoordinates::gcov(const Loci loc, const int& j, const int& i, const int mu, const int nu) const
 {
-    GReal X[GR_DIM], gcov[GR_DIM][GR_DIM];
+    if (cache_geometry) return gcov_direct(loc, j, i, sym_idx(mu, nu));
+    GReal X[GR_DIM];
     coord(0, j, i, loc, X);
-    coords.gcov_native(X, gcov);
-    return gcov[mu][nu];
+    return coords.gcov_native(X, mu, nu);
 }
 KOKKOS_INLINE_FUNCTION Real GRCoordinates::gdet(const Loci loc, const int& j, const int& i) const
 {
-    GReal X[GR_DIM], gcon[GR_DIM][GR_DIM];
+    if (cache_geometry) return gdet_direct(loc, j, i);
+    GReal X[GR_DIM];
     coord(0, j, i, loc, X);
-    return coords.gcon_native(X, gcon);
+    return coords.gdet_native_fast(X);
 }
+// Without a cache, each component costs a full connection evaluation:
+// loops over components should call the array versions below once per zone instead
 KOKKOS_INLINE_FUNCTION Real GRCoordinates::conn(const int& j, const int& i, const int mu, const int nu, const int lam) const
 {
-    GReal X[GR_DIM], conn[GR_DIM][GR_DIM][GR_DIM];
-    coord(0, j, i, Loci::center, X);
-    coords.conn_native(X, conn);
-    return conn[mu][nu][lam];
+    if (cache_geometry) return conn_direct(j, i, mu, sym_idx(nu, lam));
+    Real conn_loc[GR_DIM][GR_DIM][GR_DIM];
+    conn(j, i, conn_loc);
+    return conn_loc[mu][nu][lam];
+}
+KOKKOS_INLINE_FUNCTION Real GRCoordinates::gdet_conn(const int& j, const int& i, const int mu, const int nu, const int lam) const
+{
+    if (cache_geometry) return gdet_conn_direct(j, i, mu, sym_idx(nu, lam));
+    return gdet(Loci::center, j, i) * conn(j, i, mu, nu, lam);
 }
 
+// Unpack each independent component once, filling both symmetric slots
 KOKKOS_INLINE_FUNCTION void GRCoordinates::gcon(const Loci loc, const int& j, const int& i, Real gcon[GR_DIM][GR_DIM]) const
 {
-    GReal X[GR_DIM];
-    coord(0, j, i, loc, X);
-    coords.gcon_native(X, gcon);
+    if (cache_geometry) {
+        DLOOP2S gcon[mu][nu] = gcon[nu][mu] = gcon_direct(loc, j, i, sym_idx(mu, nu));
+    } else {
+        GReal X[GR_DIM];
+        coord(0, j, i, loc, X);
+        coords.gcon_native(X, gcon);
+    }
 }
 KOKKOS_INLINE_FUNCTION void GRCoordinates::gcov(const Loci loc, const int& j, const int& i, Real gcov[GR_DIM][GR_DIM]) const
 {
-    GReal X[GR_DIM];
-    coord(0, j, i, loc, X);
-    coords.gcov_native(X, gcov);
+    if (cache_geometry) {
+        DLOOP2S gcov[mu][nu] = gcov[nu][mu] = gcov_direct(loc, j, i, sym_idx(mu, nu));
+    } else {
+        GReal X[GR_DIM];
+        coord(0, j, i, loc, X);
+        coords.gcov_native(X, gcov);
+    }
 }
 KOKKOS_INLINE_FUNCTION void GRCoordinates::conn(const int& j, const int& i, Real conn[GR_DIM][GR_DIM][GR_DIM]) const
 {
-    GReal X[GR_DIM];
-    coord(0, j, i, Loci::center, X);
-    coords.conn_native(X, conn);
+    if (cache_geometry) {
+        DLOOP3S conn[mu][nu][lam] = conn[mu][lam][nu] = conn_direct(j, i, mu, sym_idx(nu, lam));
+    } else {
+        GReal X[GR_DIM];
+        coord(0, j, i, Loci::center, X);
+        coords.conn_native(X, CONN_DELTA, conn);
+    }
 }
-#else
-KOKKOS_INLINE_FUNCTION Real GRCoordinates::gcon(const Loci loc, const int& j, const int& i, const int mu, const int nu) const
-{ return gcon_direct(loc, j, i, mu, nu); }
-KOKKOS_INLINE_FUNCTION Real GRCoordinates::gcov(const Loci loc, const int& j, const int& i, const int mu, const int nu) const
-{ return gcov_direct(loc, j, i, mu, nu); }
-KOKKOS_INLINE_FUNCTION Real GRCoordinates::gdet(const Loci loc, const int& j, const int& i) const
-{ return gdet_direct(loc, j, i); }
-KOKKOS_INLINE_FUNCTION Real GRCoordinates::conn(const int& j, const int& i, const int mu, const int nu, const int lam) const
-{ return conn_direct(j, i, mu, nu, lam); }
-KOKKOS_INLINE_FUNCTION Real GRCoordinates::gdet_conn(const int& j, const int& i, const int mu, const int nu, const int lam) const
-{ return gdet_conn_direct(j, i, mu, nu, lam); }
-
-KOKKOS_INLINE_FUNCTION void GRCoordinates::gcon(const Loci loc, const int& j, const int& i, Real gcon[GR_DIM][GR_DIM]) const
-{ DLOOP2 gcon[mu][nu] = gcon_direct(loc, j, i, mu, nu); }
-KOKKOS_INLINE_FUNCTION void GRCoordinates::gcov(const Loci loc, const int& j, const int& i, Real gcov[GR_DIM][GR_DIM]) const
-{ DLOOP2 gcov[mu][nu] = gcov_direct(loc, j, i, mu, nu); }
-KOKKOS_INLINE_FUNCTION void GRCoordinates::conn(const int& j, const int& i, Real conn[GR_DIM][GR_DIM][GR_DIM]) const
-{ DLOOP3 conn[mu][nu][lam] = conn_direct(j, i, mu, nu, lam); }
 KOKKOS_INLINE_FUNCTION void GRCoordinates::gdet_conn(const int& j, const int& i, Real gdet_conn[GR_DIM][GR_DIM][GR_DIM]) const
-{ DLOOP3 gdet_conn[mu][nu][lam] = gdet_conn_direct(j, i, mu, nu, lam); }
+{
+    if (cache_geometry) {
+        DLOOP3S gdet_conn[mu][nu][lam] = gdet_conn[mu][lam][nu] = gdet_conn_direct(j, i, mu, sym_idx(nu, lam));
+    } else {
+        conn(j, i, gdet_conn);
+        const Real gdet_loc = gdet(Loci::center, j, i);
+        DLOOP3 gdet_conn[mu][nu][lam] *= gdet_loc;
+    }
+}
 
 #endif
 
@@ -92,6 +92,24 @@ using GReal = double;
 #define DLOOP3 DLOOP2 for(int lam = 0; lam < GR_DIM; ++lam)
 #define DLOOP4 DLOOP3 for(int kap = 0; kap < GR_DIM; ++kap)
 
+// The metric is symmetric, and the connection symmetric in its lower two indices,
+// so we cache only the GR_DIM_SYM independent components of each.
+// DLOOP2S/DLOOP3S iterate over just those components
+#define GR_DIM_SYM 10
+#define DLOOP2S DLOOP1 for(int nu = mu; nu < GR_DIM; ++nu)
+#define DLOOP3S DLOOP1 for(int nu = 0; nu < GR_DIM; ++nu) for(int lam = nu; lam < GR_DIM; ++lam)
+
+/**
+ * Index of the component (mu,nu) of a symmetric 4x4 tensor in packed storage:
+ * rows of the upper triangle, i.e. 00,01,02,03,11,12,13,22,23,33
+ */
+KOKKOS_FORCEINLINE_FUNCTION int sym_idx(const int& mu, const int& nu)
+{
+    const int a = (mu < nu) ? mu : nu;
+    const int b = (mu < nu) ? nu : mu;
+    return a*(2*GR_DIM - 1 - a)/2 + b;
+}
+
 #define NVEC 3
 #define VLOOP for(int v = 0; v < NVEC; ++v)
 #define VLOOP2 VLOOP for(int w = 0; w < NVEC; ++w)
@@ -168,6 +186,7 @@ inline int MPIBarrier()
 using GridScalar = parthenon::ParArrayND<parthenon::Real>;
 using GridVector = parthenon::ParArrayND<parthenon::Real>;
 // Shape+2D ("Geom") versions for symmetric geometry
+// Tensors are packed in their symmetric indices, see sym_idx
 using GeomScalar = parthenon::ParArrayND<parthenon::Real>;
 using GeomTensor2 = parthenon::ParArrayND<parthenon::Real>;
 using GeomTensor3 = parthenon::ParArrayND<parthenon::Real>;
@@ -0,0 +1,139 @@
+
+/* 
+ *  File: block_cost.cpp
+ *  
+ *  BSD 3-Clause License
+ *  
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *  
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *  
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *  
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "block_cost.hpp"
+
+#include "domain.hpp"
+#include "implicit.hpp"
+#include "invert_template.hpp"
+
+using namespace parthenon;
+
+std::shared_ptr<KHARMAPackage> BlockCost::Initialize(ParameterInput *pin, std::shared_ptr<Packages_t>& packages)
+{
+    Flag("Initializing BlockCost");
+    auto pkg = std::make_shared<KHARMAPackage>("BlockCost");
+    Params &params = pkg->AllParams();
+
+    // Cost of each event, over and above the cost of stepping an ordinary zone
+    Real fixup = pin->GetOrAddReal("block_cost", "fixup", 2.0);
+    params.Add("fixup", fixup);
+    Real floor = pin->GetOrAddReal("block_cost", "floor", 0.5);
+    params.Add("floor", floor);
+    Real solve_fail = pin->GetOrAddReal("block_cost", "solve_fail", 4.0);
+    params.Add("solve_fail", solve_fail);
+    if (fixup < 0. || floor < 0. || solve_fail < 0.)
+        throw std::invalid_argument("Block cost weights must be non-negative!");
+
+    // Steps to average over before updating costs.  Each update may move blocks, so this
+    // should be long compared to the cost of a rebalance
+    int interval = pin->GetOrAddInteger("block_cost", "interval", 100);
+    if (interval < 1)
+        throw std::invalid_argument("Block cost interval must be at least 1!");
+    params.Add("interval", interval);
+
+    // Parthenon reads the balancer when building the Mesh, after packages are loaded
+    pin->SetString("parthenon/loadbalancing", "balancer", "manual");
+
+    // Running totals for each block, by gid, and the number of steps they cover
+    params.Add("costs", std::map<int, Real>(), true);
+    params.Add("nsteps", 0, true);
+
+    pkg->PostStepWork = BlockCost::PostStepWork;
+
+    EndFlag();
+    return pkg;
+}
+
+Real BlockCost::EstimateCost(MeshBlockData<Real> *rc)
+{
+    auto pmb = rc->GetBlockPointer();
+    auto& pars = pmb->packages.Get("BlockCost")->AllParams();
+    const Real w_fixup = pars.Get<Real>("fixup");
+    const Real w_floor = pars.Get<Real>("floor");
+    const Real w_solve_fail = pars.Get<Real>("solve_fail");
+
+    // Any of these might not exist, depending on which packages are loaded
+    auto pflag = rc->PackVariables(std::vector<std::string>{"pflag"});
+    auto fflag = rc->PackVariables(std::vector<std::string>{"fflag"});
+    auto solve_fail = rc->PackVariables(std::vector<std::string>{"solve_fail"});
+    const bool use_pflag = pflag.GetDim(4) > 0;
+    const bool use_fflag = fflag.GetDim(4) > 0;
+    const bool use_solve_fail = solve_fail.GetDim(4) > 0;
+
+    const IndexRange3 b = KDomain::GetRange(rc, IndexDomain::interior);
+    Real cost = 0.;
+    pmb->par_reduce("block_cost", b.ks, b.ke, b.js, b.je, b.is, b.ie,
+        KOKKOS_LAMBDA (const int k, const int j, const int i, Real &local_result) {
+            Real zone_cost = 1.;
+            if (use_pflag && (int) pflag(0, k, j, i) > (int) Inverter::Status::success)
+                zone_cost += w_fixup;
+            if (use_fflag && (int) fflag(0, k, j, i) != 0)
+                zone_cost += w_floor;
+            if (use_solve_fail && (int) solve_fail(0, k, j, i) != (int) Implicit::SolverStatus::converged)
+                zone_cost += w_solve_fail;
+            local_result += zone_cost;
+        }
+    , Kokkos::Sum<Real>(cost));
+    return cost;
+}
+
+void BlockCost::PostStepWork(Mesh *pmesh, ParameterInput *pin, const SimTime &tm)
+{
+    Flag("BlockCost::PostStepWork");
+    auto& pars = pmesh->packages.Get("BlockCost")->AllParams();
+    const int interval = pars.Get<int>("interval");
+
+    // Blocks may have moved or been refined since the last update: drop any we no longer have
+    auto costs = pars.Get<std::map<int, Real>>("costs");
+    std::map<int, Real> new_costs;
+    for (auto &pmb : pmesh->block_list) {
+        const Real cost = EstimateCost(pmb->meshblock_data.Get().get());
+        new_costs[pmb->gid] = (costs.count(pmb->gid) ? costs.at(pmb->gid) : 0.) + cost;
+    }
+    const int nsteps = pars.Get<int>("nsteps") + 1;
+
+    if (nsteps >= interval) {
+        // Parthenon only rebalances when costs are set, so set all of ours at once
+        for (auto &pmb : pmesh->block_list) {
+            pmb->SetCostForLoadBalancing(new_costs.at(pmb->gid) / nsteps);
+        }
+        new_costs.clear();
+        pars.Update("nsteps", 0);
+    } else {
+        pars.Update("nsteps", nsteps);
+    }
+    pars.Update("costs", new_costs);
+
+    EndFlag();
+}
@@ -0,0 +1,67 @@
+
+/* 
+ *  File: block_cost.hpp
+ *  
+ *  BSD 3-Clause License
+ *  
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *  
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *  
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *  
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include "decs.hpp"
+#include "types.hpp"
+
+/**
+ * Cost-weighted load balancing.
+ *
+ * The cost of stepping a MeshBlock is far from uniform: zones where the inversion fails must be fixed up,
+ * floors must be applied and zones re-inverted, and the implicit solver runs to its iteration limit wherever
+ * it fails to converge.  These cluster near the horizon and in the jet, so balancing by block count
+ * leaves some ranks waiting on others.
+ *
+ * Each step, we count these events in every block, and estimate the block's cost as the number of zones
+ * plus a weighted count of each event.  Every <block_cost>/interval steps, the averaged estimate is handed
+ * to Parthenon as the block's load balancing cost, and Parthenon redistributes the blocks to equalize it.
+ */
+namespace BlockCost {
+/**
+ * Read the event weights & reporting interval, and switch Parthenon to user-provided ("manual") costs
+ */
+std::shared_ptr<KHARMAPackage> Initialize(ParameterInput *pin, std::shared_ptr<Packages_t>& packages);
+
+/**
+ * Estimated cost of the last step of one block, in units of one ordinary zone
+ */
+Real EstimateCost(MeshBlockData<Real> *rc);
+
+/**
+ * Accumulate the cost of each block, and pass the average to Parthenon every <block_cost>/interval steps
+ */
+void PostStepWork(Mesh *pmesh, ParameterInput *pin, const SimTime &tm);
+
+}
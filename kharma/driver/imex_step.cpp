@@ -70,7 +70,6 @@ TaskCollection KHARMADriver::MakeImExTaskCollection(BlockList_t &blocks, int sta
     const bool use_electrons = pkgs.count("Electrons");
     const bool use_implicit = pkgs.count("Implicit");
     const bool use_jcon = pkgs.count("Current");
-    const bool use_linesearch = (use_implicit) ? pkgs.at("Implicit")->Param<bool>("linesearch") : false;
 
     // Allocate/copy the things we need
     // TODO these can now be reduced by including the var lists/flags which actually need to be allocated
@@ -90,11 +89,8 @@ TaskCollection KHARMADriver::MakeImExTaskCollection(BlockList_t &blocks, int sta
         if (use_implicit) {
             // When solving, we need a temporary copy with any explicit updates,
             // but not overwriting the beginning- or mid-step values
+            // The linesearch state lives in the solver's scratch, so needs no container
             pmesh->mesh_data.Add("solver");
-            if (use_linesearch) {
-                // Need an additional state for linesearch
-                pmesh->mesh_data.Add("linesearch");
-            }
         }
     }
 
@@ -120,7 +116,6 @@ TaskCollection KHARMADriver::MakeImExTaskCollection(BlockList_t &blocks, int sta
         // '_sub_step_final' refers to the fluid state at the end of the sub step (Sf in iharm3d)
         // '_flux_src' refers to the mesh object corresponding to -divF + S
         // '_solver' refers to the fluid state passed to the Implicit solver. At the end of the solve
-        // '_linesearch' refers to the fluid state updated while performing a linesearch in the solver
         // copy P and U from solver state to sub_step_final state.
         auto &md_full_step_init = pmesh->mesh_data.GetOrAdd("base", i);
         auto &md_sub_step_init  = pmesh->mesh_data.GetOrAdd(integrator->stage_name[stage - 1], i);
@@ -178,33 +173,12 @@ TaskCollection KHARMADriver::MakeImExTaskCollection(BlockList_t &blocks, int sta
 
         // Update the explicitly-evolved variables using the source term
         // Add any proportion of the step start required by the integrator (e.g., RK2)
-        auto t_avg_data_c = tl.AddTask(t_sources, Update::WeightedSumData<std::vector<MetadataFlag>, MeshData<Real>>,
-                                    std::vector<MetadataFlag>({Metadata::GetUserFlag("Explicit"), Metadata::Independent, Metadata::Cell}),
-                                    md_sub_step_init.get(), md_full_step_init.get(),
-                                    integrator->gam0[stage-1], integrator->gam1[stage-1],
-                                    md_solver.get());
-        auto t_avg_data = t_avg_data_c;
-        if (use_b_ct) {
-            t_avg_data = tl.AddTask(t_avg_data_c, WeightedSumDataFace,
-                                    std::vector<MetadataFlag>({Metadata::GetUserFlag("Explicit"), Metadata::Independent, Metadata::Face}),
-                                    md_sub_step_init.get(), md_full_step_init.get(),
+        auto t_update = tl.AddTask(t_sources, StageUpdate,
+                                    std::vector<MetadataFlag>({Metadata::GetUserFlag("Explicit"), Metadata::Independent}),
+                                    md_sub_step_init.get(), md_full_step_init.get(), md_flux_src.get(),
                                     integrator->gam0[stage-1], integrator->gam1[stage-1],
+                                    integrator->beta[stage-1] * integrator->dt,
                                     md_solver.get());
-        }
-        // apply du/dt to the result
-        auto t_update_c = tl.AddTask(t_sources, Update::WeightedSumData<std::vector<MetadataFlag>, MeshData<Real>>,
-                                    std::vector<MetadataFlag>({Metadata::GetUserFlag("Explicit"), Metadata::Independent, Metadata::Cell}),
-                                    md_solver.get(), md_flux_src.get(),
-                                    1.0, integrator->beta[stage-1] * integrator->dt,
-                                    md_solver.get());
-        auto t_update = t_update_c;
-        if (use_b_ct) {
-            t_update = tl.AddTask(t_update_c, WeightedSumDataFace,
-                                  std::vector<MetadataFlag>({Metadata::GetUserFlag("Explicit"), Metadata::Independent, Metadata::Face}),
-                                  md_solver.get(), md_flux_src.get(),
-                                  1.0, integrator->beta[stage-1] * integrator->dt,
-                                  md_solver.get());
-        }
 
         // If evolving GRMHD explicitly, UtoP needs a guess in order to converge, so we copy in md_sub_step_init
         auto t_copy_prims = t_update;
@@ -222,31 +196,20 @@ TaskCollection KHARMADriver::MakeImExTaskCollection(BlockList_t &blocks, int sta
 
         auto t_implicit = t_explicit;
         if (use_implicit) {
-            // Extra containers for implicit solve
-            std::shared_ptr<MeshData<Real>> &md_linesearch = (use_linesearch) ? pmesh->mesh_data.GetOrAdd("linesearch", i) : md_solver;
-
             // Copy the current state of any implicitly-evolved vars (at least the prims) in as a guess.
             // This sets md_solver = md_sub_step_init
             auto t_copy_guess = tl.AddTask(t_sources, Copy<MeshData<Real>>, std::vector<MetadataFlag>({Metadata::GetUserFlag("Implicit")}),
                                         md_sub_step_init.get(), md_solver.get());
 
-            auto t_guess_ready = t_explicit | t_copy_guess;
-
             // The `solver` MeshData object now has the implicit primitives corresponding to initial/half step and
             // explicit variables have been updated to match the current step.
-            // Copy the primitives to the `linesearch` MeshData object if linesearch was enabled.
-            auto t_copy_linesearch = t_guess_ready;
-            if (use_linesearch) {
-                t_copy_linesearch = tl.AddTask(t_guess_ready, Copy<MeshData<Real>>, std::vector<MetadataFlag>({Metadata::GetUserFlag("Primitive")}),
-                                                md_solver.get(), md_linesearch.get());
-            }
-
+            auto t_guess_ready = t_explicit | t_copy_guess;
 
             // Time-step implicit variables by root-finding the residual.
             // This calculates the primitive values after the substep for all "isImplicit" variables --
             // no need for separately adding the flux divergence or calling UtoP
-            auto t_implicit_step = tl.AddTask(t_copy_linesearch, Implicit::Step, md_full_step_init.get(), md_sub_step_init.get(), 
-                                         md_flux_src.get(), md_linesearch.get(), md_solver.get(), integrator->beta[stage-1] * integrator->dt);
+            auto t_implicit_step = tl.AddTask(t_guess_ready, Implicit::Step, md_full_step_init.get(), md_sub_step_init.get(), 
+                                         md_flux_src.get(), md_solver.get(), integrator->beta[stage-1] * integrator->dt);
 
             // Copy the entire solver state (everything defined on the grid, incl. our new Face variables) into the final state md_sub_step_final
             // If we're entirely explicit, we just declare these equal
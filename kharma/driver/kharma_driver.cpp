@@ -71,6 +71,36 @@ std::shared_ptr<KHARMAPackage> KHARMADriver::Initialize(ParameterInput *pin, std
     params.Add("type", driver_type);
     params.Add("name", driver_type_s);
 
+    // Time integrator.  Anything Parthenon provides, or "ssprk43", the 4-stage, 3rd-order SSP method,
+    // which is set up in SetIntegrator.  Parthenon must construct something, so we ask for RK3 in its place.
+    // The input as written to restart files then says RK3, so we record the real choice under <driver>
+    std::string integrator = pin->GetOrAddString("parthenon/time", "integrator", "rk2");
+    if (integrator == "rk3" && pin->DoesParameterExist("driver", "integrator") &&
+        pin->GetString("driver", "integrator") == "ssprk43") {
+        integrator = "ssprk43";
+    }
+    if (integrator == "ssprk43") {
+        pin->SetString("parthenon/time", "integrator", "rk3");
+    }
+    pin->SetString("driver", "integrator", integrator);
+    params.Add("integrator", integrator);
+
+    // Keep every intermediate stage in one container, updated in place, rather than one container per stage.
+    // Correct for any integrator combining only the step start & the last stage, i.e. all but rk4
+    bool low_storage = pin->GetOrAddBoolean("driver", "low_storage", false);
+    if (low_storage) {
+        if (driver_type != DriverType::kharma)
+            throw std::invalid_argument("Low-storage stepping is only implemented for the KHARMA driver!");
+        if (integrator == "rk4")
+            throw std::invalid_argument("Low-storage stepping requires an integrator using only the step start and last stage!");
+        // Electron heating compares the entropy at the start and end of each stage
+        if (pin->GetOrAddBoolean("electrons", "on", false))
+            throw std::invalid_argument("Low-storage stepping does not support electron heating!");
+        if (pin->GetOrAddBoolean("driver", "multirate", false) || pin->GetOrAddBoolean("multizone", "on", false))
+            throw std::invalid_argument("Low-storage stepping does not support multi-rate or multizone stepping!");
+    }
+    params.Add("low_storage", low_storage);
+
     // Synchronize boundary variables twice. Ensures KHARMA is agnostic to the breakdown
     // of meshblocks, at the cost of twice the MPI overhead, for potentially worse strong scaling.
     // On by default, disable only after testing that, e.g., divB meets your requirements
@@ -81,6 +111,28 @@ std::shared_ptr<KHARMAPackage> KHARMADriver::Initialize(ParameterInput *pin, std
     std::string flux = pin->GetOrAddString("driver", "flux", "llf");
     params.Add("use_hlle", (flux == "hlle"));
 
+    // Calculate fluxes in a single kernel per direction, keeping the reconstructed
+    // face states in scratch rather than writing them to the "Flux.Pl" etc. temporaries.
+    // Saves memory and bandwidth, but needs more scratch per team
+    bool fused_flux = pin->GetOrAddBoolean("driver", "fused_flux", false);
+    params.Add("fused_flux", fused_flux);
+    // Invert, apply floors, and mark zones for fixup in a single pass over each MeshData.
+    // Only used where every UtoP & floor is handled by the fused kernel, see Inverter::MeshUtoPFloorsFix
+    bool fused_utop = pin->GetOrAddBoolean("driver", "fused_utop", false);
+    params.Add("fused_utop", fused_utop);
+    // Invert the interior zones while the boundary exchange is in flight, leaving only the
+    // MPI ghost zones to invert once it completes.  Not compatible with the fused kernel above
+    bool overlap_comms = pin->GetOrAddBoolean("driver", "overlap_comms", false);
+    if (overlap_comms && fused_utop)
+        throw std::invalid_argument("Cannot overlap communication with a fused UtoP!");
+    if (overlap_comms && pin->GetOrAddString("parthenon/mesh", "refinement", "none") != "none")
+        throw std::invalid_argument("Overlapping communication is not supported with mesh refinement!");
+    params.Add("overlap_comms", overlap_comms);
+    // Look up the MeshData objects for each stage & partition once, rather than every stage
+    // of every step.  They're re-made whenever blocks are refined, derefined, or load-balanced
+    bool cache_stage_data = pin->GetOrAddBoolean("driver", "cache_stage_data", false);
+    params.Add("cache_stage_data", cache_stage_data);
+
     // Reconstruction scheme.  TODO bunch more here, PPM esp...
     std::vector<std::string> allowed_vals = {"donor_cell", "linear_mc", "weno5"};
     std::string recon = pin->GetOrAddString("driver", "reconstruction", "weno5", allowed_vals);
@@ -149,6 +201,30 @@ std::shared_ptr<KHARMAPackage> KHARMADriver::Initialize(ParameterInput *pin, std
     return pkg;
 }
 
+void KHARMADriver::SetIntegrator(ParameterInput *pin)
+{
+    const auto &name = pmesh->packages.Get("Driver")->Param<std::string>("integrator");
+    // Only if nothing (e.g. the Implicit package) overrode the integrator after we set it
+    if (name == "ssprk43" && pin->GetString("parthenon/time", "integrator") == "rk3") {
+        // SSPRK(4,3), with SSP coefficient 2.  In the form used by all our steps,
+        // U_final = gam0 * U_sub_step_init + gam1 * U_full_step_init + beta * dt * dU/dt
+        integrator->nstages = 4;
+        integrator->delta = {1.0, 0.0, 0.0, 0.0};
+        integrator->gam0 = {0.0, 1.0, 1./3, 1.0};
+        integrator->gam1 = {1.0, 0.0, 2./3, 0.0};
+        integrator->beta = {0.5, 0.5, 1./6, 0.5};
+        integrator->stage_name = {"base", "1", "2", "3", "base"};
+    }
+}
+
+std::string KHARMADriver::StageContainer(int stage)
+{
+    // Under low-storage stepping, all intermediate stages share one container
+    if (pmesh->packages.Get("Driver")->Param<bool>("low_storage") && stage > 0 && stage < integrator->nstages)
+        return "stage";
+    return integrator->stage_name[stage];
+}
+
 void KHARMADriver::AddFullSyncRegion(TaskCollection& tc, std::shared_ptr<MeshData<Real>> &md_sync)
 {
     const TaskID t_none(0);
@@ -163,7 +239,8 @@ void KHARMADriver::AddFullSyncRegion(TaskCollection& tc, std::shared_ptr<MeshDat
     }
 }
 
-TaskID KHARMADriver::AddBoundarySync(const TaskID t_start, TaskList &tl, std::shared_ptr<MeshData<Real>> &mc1)
+TaskID KHARMADriver::AddBoundarySync(const TaskID t_start, TaskList &tl, std::shared_ptr<MeshData<Real>> &mc1,
+                                     TaskID *t_send)
 {
     Flag("AddBoundarySync");
     auto t_start_sync = t_start;
@@ -176,7 +253,18 @@ TaskID KHARMADriver::AddBoundarySync(const TaskID t_start, TaskList &tl, std::sh
     // The Parthenon exchange tasks include applying physical boundary conditions now.
     // We generally do not take advantage of this yet, but good to know when reasoning about initialization.
     Flag("ParthenonAddSync");
-    auto t_sync_done = parthenon::AddBoundaryExchangeTasks(t_start_sync, tl, mc1, multilevel);
+    TaskID t_sync_done;
+    if (t_send != nullptr && !multilevel) {
+        // Same tasks as AddBoundaryExchangeTasks, spelled out so the caller can wait on sending alone
+        using parthenon::BoundaryType;
+        *t_send = tl.AddTask(t_start_sync, parthenon::SendBoundBufs<BoundaryType::any>, mc1);
+        auto t_recv = tl.AddTask(t_start_sync, parthenon::ReceiveBoundBufs<BoundaryType::any>, mc1);
+        auto t_set = tl.AddTask(t_recv, parthenon::SetBounds<BoundaryType::any>, mc1);
+        t_sync_done = tl.AddTask(t_set, parthenon::ApplyBoundaryConditionsOnCoarseOrFineMD, mc1, false);
+    } else {
+        t_sync_done = parthenon::AddBoundaryExchangeTasks(t_start_sync, tl, mc1, multilevel);
+        if (t_send != nullptr) *t_send = t_sync_done;
+    }
     auto t_bounds = t_sync_done;
     EndFlag();
 
@@ -286,6 +374,15 @@ TaskID KHARMADriver::AddFluxCalculations(TaskID& t_start, TaskList& tl, KReconst
     return t_ctop;
 }
 
+TaskListStatus KHARMADriver::Step()
+{
+    if (pmesh->packages.AllPackages().count("Multirate"))
+        return MultirateStep();
+    if (pmesh->packages.AllPackages().count("Multizone"))
+        return MultizoneStep();
+    return MultiStageDriver::Step();
+}
+
 void KHARMADriver::SetGlobalTimeStep()
 {
   // TODO TODO apply the limits from GRMHD package here
@@ -314,3 +411,51 @@ void KHARMADriver::PostExecute(DriverStatus status)
     Packages::PostExecute(pmesh, pinput, tm);
     EvolutionDriver::PostExecute(status);
 }
+
+TaskStatus KHARMADriver::StageUpdate(const std::vector<MetadataFlag> &flags, MeshData<Real> *md_sub_step_init,
+                                     MeshData<Real> *md_full_step_init, MeshData<Real> *md_flux_src,
+                                     const Real gam0, const Real gam1, const Real beta_dt, MeshData<Real> *md_sub_step_final)
+{
+    Flag("StageUpdate");
+    // Cell-centered variables
+    std::vector<MetadataFlag> flags_c(flags), flags_f(flags);
+    flags_c.push_back(Metadata::Cell);
+    const auto &x = md_sub_step_init->PackVariables(flags_c);
+    const auto &y = md_full_step_init->PackVariables(flags_c);
+    const auto &dudt = md_flux_src->PackVariables(flags_c);
+    const auto &z = md_sub_step_final->PackVariables(flags_c);
+    if (x.GetDim(4) > 0) {
+        parthenon::par_for(
+            DEFAULT_LOOP_PATTERN, "StageUpdate", DevExecSpace(), 0, x.GetDim(5) - 1, 0,
+            x.GetDim(4) - 1, 0, x.GetDim(3) - 1, 0, x.GetDim(2) - 1, 0, x.GetDim(1) - 1,
+            KOKKOS_LAMBDA(const int b, const int l, const int k, const int j, const int i) {
+                // Same check (and same order of operations) as the two WeightedSumData calls this replaces
+                if (x.IsAllocated(b, l) && y.IsAllocated(b, l) && dudt.IsAllocated(b, l) && z.IsAllocated(b, l)) {
+                    z(b, l, k, j, i) = (gam0 * x(b, l, k, j, i) + gam1 * y(b, l, k, j, i))
+                                        + beta_dt * dudt(b, l, k, j, i);
+                }
+            });
+    }
+
+    // Face-centered variables, i.e. B_CT
+    flags_f.push_back(Metadata::Face);
+    const auto &xf = md_sub_step_init->PackVariables(flags_f);
+    const auto &yf = md_full_step_init->PackVariables(flags_f);
+    const auto &dudtf = md_flux_src->PackVariables(flags_f);
+    const auto &zf = md_sub_step_final->PackVariables(flags_f);
+    if (xf.GetDim(4) > 0) {
+        parthenon::par_for(
+            DEFAULT_LOOP_PATTERN, "StageUpdateFace", DevExecSpace(), 0, xf.GetDim(5) - 1, 0,
+            xf.GetDim(4) - 1, 0, xf.GetDim(3) - 1, 0, xf.GetDim(2) - 1, 0, xf.GetDim(1) - 1,
+            KOKKOS_LAMBDA(const int b, const int l, const int k, const int j, const int i) {
+                if (xf.IsAllocated(b, l) && yf.IsAllocated(b, l) && dudtf.IsAllocated(b, l) && zf.IsAllocated(b, l)) {
+                    for (TE el : {TE::F1, TE::F2, TE::F3})
+                        zf(b, el, l, k, j, i) = (gam0 * xf(b, el, l, k, j, i) + gam1 * yf(b, el, l, k, j, i))
+                                                + beta_dt * dudtf(b, el, l, k, j, i);
+                }
+            });
+    }
+
+    EndFlag();
+    return TaskStatus::complete;
+}
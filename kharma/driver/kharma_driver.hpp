@@ -55,7 +55,7 @@ enum class DriverType{kharma, imex, simple};
  */
 class KHARMADriver : public MultiStageDriver {
     public:
-        KHARMADriver(ParameterInput *pin, ApplicationInput *app_in, Mesh *pm) : MultiStageDriver(pin, app_in, pm) {}
+        KHARMADriver(ParameterInput *pin, ApplicationInput *app_in, Mesh *pm) : MultiStageDriver(pin, app_in, pm) { SetIntegrator(pin); }
 
         static std::shared_ptr<KHARMAPackage> Initialize(ParameterInput *pin, std::shared_ptr<Packages_t>& packages);
 
@@ -68,6 +68,12 @@ class KHARMADriver : public MultiStageDriver {
         // And the PostExecute, so we can add a package callback here
         void PostExecute(DriverStatus status) override;
 
+        /**
+         * Take a step.  This is Parthenon's usual multi-stage step, calling MakeTaskCollection for each stage,
+         * unless multi-rate or multizone stepping is enabled, in which case it calls MultirateStep or MultizoneStep.
+         */
+        TaskListStatus Step() override;
+
         /**
          * A Driver object orchestrates everything that has to be done to a mesh to take a step.
          * The function MakeTaskCollection outlines everything to be done in one sub-step,
@@ -107,6 +113,44 @@ class KHARMADriver : public MultiStageDriver {
          */
         TaskCollection MakeSimpleTaskCollection(BlockList_t &blocks, int stage);
 
+        /**
+         * Multi-rate step: sort blocks into bins by their local timestep, then subcycle lower bins within
+         * one step of the highest bin, correcting fluxes at the end.  See multirate.hpp.
+         * Only follows the default (KHARMA) driver's order of operations.
+         */
+        TaskListStatus MultirateStep();
+
+        /**
+         * One stage of one substep of a multi-rate step.  Bins due for a step this substep take a stage with
+         * their own dt_base * 2^bin.  Others present neighbors with their state as of their own last step,
+         * which the base container holds.
+         */
+        TaskCollection MakeMultirateTaskCollection(int stage, int substep, Real dt_base);
+
+        /**
+         * End of a multi-rate step: exchange flux registers, correct bin interfaces, and finish the step
+         * on the full mesh as MakeDefaultTaskCollection would on its last stage.
+         */
+        TaskCollection MakeRefluxTaskCollection();
+
+        /**
+         * Multizone step: take a step over only the MeshBlocks in the current annulus, moving to the next
+         * annulus each <multizone>/zone_time.  See multizone.hpp.
+         */
+        TaskListStatus MultizoneStep();
+
+        /**
+         * One stage of a multizone step, following MakeDefaultTaskCollection for blocks in the annulus.
+         * All blocks still exchange boundaries, so frozen blocks provide boundary values to the annulus.
+         */
+        TaskCollection MakeMultizoneTaskCollection(int stage);
+
+        /**
+         * The variables exchanged between blocks during a step: primitive, conserved, and face fields,
+         * plus anything in the "Boundaries" package (e.g. Dirichlet boundary buffers)
+         */
+        std::vector<std::string> &SyncVars();
+
         // The different drivers share substantially similar portions of the full task list, which we gather into
 
         /**
@@ -126,8 +170,11 @@ class KHARMADriver : public MultiStageDriver {
          * 
          * This sequence is used identically in several places, so it makes sense
          * to define once and use elsewhere.
+         * If t_send is given, it is set to the task which sends this rank's boundary buffers
+         * (or, with mesh refinement, to the end of the whole exchange).
          */
-        static TaskID AddBoundarySync(const TaskID t_start, TaskList &tl, std::shared_ptr<MeshData<Real>> &md);
+        static TaskID AddBoundarySync(const TaskID t_start, TaskList &tl, std::shared_ptr<MeshData<Real>> &md,
+                                      TaskID *t_send = nullptr);
 
         /**
          * Calculate the fluxes in each direction
@@ -186,4 +233,63 @@ class KHARMADriver : public MultiStageDriver {
             return TaskStatus::complete;
         }
 
+        /**
+         * Perform a full stage update in one pass, for cell- and face-centered variables matching 'flags':
+         * md_sub_step_final = gam0 * md_sub_step_init + gam1 * md_full_step_init + beta_dt * md_flux_src
+         * Equivalent to WeightedSumData (& WeightedSumDataFace) averaging the step states, then again to add dU/dt.
+         */
+        static TaskStatus StageUpdate(const std::vector<MetadataFlag> &flags, MeshData<Real> *md_sub_step_init,
+                                      MeshData<Real> *md_full_step_init, MeshData<Real> *md_flux_src,
+                                      const Real gam0, const Real gam1, const Real beta_dt, MeshData<Real> *md_sub_step_final);
+
+    private:
+        /**
+         * Replace the coefficients of Parthenon's integrator with those of any KHARMA-defined integrator
+         */
+        void SetIntegrator(ParameterInput *pin);
+
+        /**
+         * Name of the container holding the state after 'stage' in MakeDefaultTaskCollection.
+         * This is the integrator's stage name, except with <driver>/low_storage.
+         */
+        std::string StageContainer(int stage);
+
+        // MeshData objects used by one partition during one stage of MakeDefaultTaskCollection
+        struct StageData {
+            std::shared_ptr<MeshData<Real>> full_step_init, sub_step_init, sub_step_final, flux_src, sync, exchange;
+        };
+
+        /**
+         * Get the MeshData objects for each partition in 'stage'.  With <driver>/cache_stage_data,
+         * these are looked up once and kept until the mesh changes, rather than rebuilt each stage.
+         */
+        std::vector<StageData> &StageMeshData(int stage);
+
+        // Cached objects for each stage, and the block gids & base container they were made for
+        std::vector<std::vector<StageData>> sd_cache;
+        std::vector<int> sd_gids;
+        MeshData<Real> *sd_base = nullptr;
+
+        /**
+         * MeshData object over the blocks in bin 'level', for the container 'label'.
+         * Cached until the block binning changes.
+         */
+        std::shared_ptr<MeshData<Real>> &MultirateData(const std::string &label, const int level);
+
+        // Multi-rate state: bin of each block in pmesh->block_list, and the gids they were assigned for.
+        // The number of blocks in each bin, and MeshData objects over each, are cached.
+        std::vector<int> mr_level, mr_gids, mr_count;
+        std::vector<std::map<std::string, std::shared_ptr<MeshData<Real>>>> mr_data;
+
+        /**
+         * MeshData object over the blocks inside (active) or outside (!active) the current multizone annulus
+         */
+        std::shared_ptr<MeshData<Real>> &MultizoneData(const std::string &label, const bool active);
+
+        // Multizone state: the current run (-1 before the first step), whether each block in
+        // pmesh->block_list is in the current annulus, and gids, counts & MeshData as above
+        int mz_run = -1;
+        std::vector<int> mz_active, mz_gids;
+        int mz_count[2];
+        std::map<std::string, std::shared_ptr<MeshData<Real>>> mz_data[2];
 };
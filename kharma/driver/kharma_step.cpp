@@ -73,6 +73,76 @@ TaskCollection KHARMADriver::MakeTaskCollection(BlockList_t &blocks, int stage)
     return tc;
 }
 
+std::vector<std::string> &KHARMADriver::SyncVars()
+{
+    static std::vector<std::string> sync_vars;
+    if (sync_vars.size() == 0) {
+        // Build the universe of variables to let Parthenon see when exchanging boundaries.
+        // This is built to exclude incidental variables like B field initialization stuff, EMFs, etc.
+        // "Boundaries" packs in buffers e.g. Dirichlet boundaries
+        using FC = Metadata::FlagCollection;
+        auto sync_flags = FC({Metadata::GetUserFlag("Primitive"), Metadata::Conserved,
+                              Metadata::Face, Metadata::GetUserFlag("Boundaries")}, true);
+        sync_vars = KHARMA::GetVariableNames(&(pmesh->packages), sync_flags);
+    }
+    return sync_vars;
+}
+
+std::vector<KHARMADriver::StageData> &KHARMADriver::StageMeshData(int stage)
+{
+    auto& pkgs = pmesh->packages.AllPackages();
+    const bool cache = pkgs.at("Driver")->Param<bool>("cache_stage_data");
+    const int num_partitions = pmesh->DefaultNumPartitions();
+
+    // Keep the objects until blocks are added, removed, or moved between ranks,
+    // or Parthenon re-creates the base container
+    std::vector<int> gids;
+    for (auto &pmb : pmesh->block_list)
+        gids.push_back(pmb->gid);
+    MeshData<Real> *base = pmesh->mesh_data.Get().get();
+    if (!cache || gids != sd_gids || base != sd_base || (int) sd_cache.size() != integrator->nstages + 1) {
+        sd_gids = gids;
+        sd_base = base;
+        sd_cache.assign(integrator->nstages + 1, {});
+    }
+
+    auto &stage_md = sd_cache[stage];
+    if ((int) stage_md.size() == num_partitions)
+        return stage_md;
+
+    auto &sync_vars = SyncVars();
+    // Optionally, exchange only the conserved variables, plus a single field to seed the inverter
+    // in ghost zones, rather than the fluid primitives as well.  Boundary conditions still operate
+    // on the full list above.
+    const bool compact_seed = pkgs.count("Inverter") && pkgs.at("Inverter")->Param<bool>("compact_seed");
+    static std::vector<std::string> exchange_vars;
+    if (exchange_vars.size() == 0) {
+        if (compact_seed) {
+            using FC = Metadata::FlagCollection;
+            auto exchange_flags = FC({Metadata::Conserved, Metadata::Face, Metadata::GetUserFlag("Boundaries")}, true);
+            exchange_vars = KHARMA::GetVariableNames(&(pmesh->packages), exchange_flags);
+            exchange_vars.push_back("utop_seed");
+        } else {
+            exchange_vars = sync_vars;
+        }
+    }
+
+    stage_md.resize(num_partitions);
+    for (int i = 0; i < num_partitions; i++) {
+        auto &sd = stage_md[i];
+        sd.full_step_init = pmesh->mesh_data.GetOrAdd("base", i);
+        sd.sub_step_init  = pmesh->mesh_data.GetOrAdd(StageContainer(stage - 1), i);
+        sd.sub_step_final = pmesh->mesh_data.GetOrAdd(StageContainer(stage), i);
+        sd.flux_src       = pmesh->mesh_data.GetOrAdd("dUdt", i);
+        // TODO this doesn't work still for some reason, even if the shallow copy has all variables
+        sd.sync = pmesh->mesh_data.AddShallow("sync"+StageContainer(stage)+std::to_string(i), sd.sub_step_final, sync_vars);
+        sd.exchange = (compact_seed) ? pmesh->mesh_data.AddShallow("exchange"+StageContainer(stage)+std::to_string(i),
+                                                                    sd.sub_step_final, exchange_vars)
+                                     : sd.sync;
+    }
+    return stage_md;
+}
+
 TaskCollection KHARMADriver::MakeDefaultTaskCollection(BlockList_t &blocks, int stage)
 {
     // Reminder that this list is created BEFORE any of the list contents are run!
@@ -91,6 +161,10 @@ TaskCollection KHARMADriver::MakeDefaultTaskCollection(BlockList_t &blocks, int
     const bool use_b_ct = pkgs.count("B_CT");
     const bool use_electrons = pkgs.count("Electrons");
     const bool use_jcon = pkgs.count("Current");
+    const bool fused_utop = driver_pkg.Get<bool>("fused_utop");
+    const bool overlap_comms = driver_pkg.Get<bool>("overlap_comms");
+    const bool low_storage = driver_pkg.Get<bool>("low_storage");
+    const bool compact_seed = pkgs.count("Inverter") && pkgs.at("Inverter")->Param<bool>("compact_seed");
 
     // Allocate/copy the things we need
     // TODO these can now be reduced by including the var lists/flags which actually need to be allocated
@@ -100,27 +174,27 @@ TaskCollection KHARMADriver::MakeDefaultTaskCollection(BlockList_t &blocks, int
         // Fluxes
         pmesh->mesh_data.Add("dUdt");
         for (int i = 1; i < integrator->nstages; i++)
-            pmesh->mesh_data.Add(integrator->stage_name[i]);
+            pmesh->mesh_data.Add(StageContainer(i));
         // Preserve state for time derivatives if we need to output current
         if (use_jcon) {
-            pmesh->mesh_data.Add("preserve");
-            // Above only copies on allocate -- ensure we copy every step
-            Copy<MeshData<Real>>({Metadata::Cell}, base.get(), pmesh->mesh_data.Get("preserve").get());
+            if (low_storage) {
+                // Current only needs the velocity & field
+                const std::vector<std::string> jcon_vars = {"prims.uvec", "prims.B"};
+                pmesh->mesh_data.Add("preserve", base, jcon_vars);
+                Update::WeightedSumData<std::vector<std::string>, MeshData<Real>>(jcon_vars, base.get(), base.get(), 1., 0.,
+                                                                                  pmesh->mesh_data.Get("preserve").get());
+            } else {
+                pmesh->mesh_data.Add("preserve");
+                // Above only copies on allocate -- ensure we copy every step
+                Copy<MeshData<Real>>({Metadata::Cell}, base.get(), pmesh->mesh_data.Get("preserve").get());
+            }
         }
     }
 
     Flag("MakeTaskCollection::fluxes");
 
-    static std::vector<std::string> sync_vars;
-    if (sync_vars.size() == 0) {
-        // Build the universe of variables to let Parthenon see when exchanging boundaries.
-        // This is built to exclude incidental variables like B field initialization stuff, EMFs, etc.
-        // "Boundaries" packs in buffers e.g. Dirichlet boundaries
-        using FC = Metadata::FlagCollection;
-        auto sync_flags = FC({Metadata::GetUserFlag("Primitive"), Metadata::Conserved,
-                              Metadata::Face, Metadata::GetUserFlag("Boundaries")}, true);
-        sync_vars = KHARMA::GetVariableNames(&(pmesh->packages), sync_flags);
-    }
+    // Per-partition MeshData objects for this stage, see StageMeshData
+    auto &stage_md = StageMeshData(stage);
 
     // Flux region: calculate and apply fluxes to update conserved values
     const int num_partitions = pmesh->DefaultNumPartitions();
@@ -132,15 +206,14 @@ TaskCollection KHARMADriver::MakeDefaultTaskCollection(BlockList_t &blocks, int
         // '_sub_step_init' refers to the fluid state at the start of the sub step (Ss in iharm3d)
         // '_sub_step_final' refers to the fluid state at the end of the sub step (Sf in iharm3d)
         // '_flux_src' refers to the mesh object corresponding to -divF + S
-        auto &md_full_step_init = pmesh->mesh_data.GetOrAdd("base", i);
-        auto &md_sub_step_init  = pmesh->mesh_data.GetOrAdd(integrator->stage_name[stage - 1], i);
-        auto &md_sub_step_final = pmesh->mesh_data.GetOrAdd(integrator->stage_name[stage], i);
-        auto &md_flux_src       = pmesh->mesh_data.GetOrAdd("dUdt", i);
-        // TODO this doesn't work still for some reason, even if the shallow copy has all variables
-        auto &md_sync = pmesh->mesh_data.AddShallow("sync"+integrator->stage_name[stage]+std::to_string(i), md_sub_step_final, sync_vars);
+        auto &md_full_step_init = stage_md[i].full_step_init;
+        auto &md_sub_step_init  = stage_md[i].sub_step_init;
+        auto &md_sub_step_final = stage_md[i].sub_step_final;
+        auto &md_flux_src       = stage_md[i].flux_src;
+        auto &md_exchange       = stage_md[i].exchange;
 
         // Start receiving flux corrections and ghost cells
-        auto t_start_recv_bound = tl.AddTask(t_none, parthenon::StartReceiveBoundBufs<parthenon::BoundaryType::any>, md_sync);
+        auto t_start_recv_bound = tl.AddTask(t_none, parthenon::StartReceiveBoundBufs<parthenon::BoundaryType::any>, md_exchange);
         auto t_start_recv_flux = t_start_recv_bound;
         if (pmesh->multilevel || use_b_ct)
             t_start_recv_flux = tl.AddTask(t_none, parthenon::StartReceiveFluxCorrections, md_sub_step_init);
@@ -180,46 +253,38 @@ TaskCollection KHARMADriver::MakeDefaultTaskCollection(BlockList_t &blocks, int
         auto t_sources = tl.AddTask(t_flux_div, Packages::AddSource, md_sub_step_init.get(), md_flux_src.get());
 
         // Perform the update using the source term
-        // Add any proportion of the step start required by the integrator (e.g., RK2)
-        // TODO splitting this is stupid, dig into Parthenon & fix
-        auto t_avg_data_c = tl.AddTask(t_sources, Update::WeightedSumData<std::vector<MetadataFlag>, MeshData<Real>>,
-                                    std::vector<MetadataFlag>({Metadata::Independent, Metadata::Cell}),
-                                    md_sub_step_init.get(), md_full_step_init.get(),
+        // Add any proportion of the step start required by the integrator (e.g., RK2),
+        // for cell- and face-centered variables in one pass
+        auto t_update = tl.AddTask(t_sources, StageUpdate, std::vector<MetadataFlag>({Metadata::Independent}),
+                                    md_sub_step_init.get(), md_full_step_init.get(), md_flux_src.get(),
                                     integrator->gam0[stage-1], integrator->gam1[stage-1],
+                                    integrator->beta[stage-1] * integrator->dt,
                                     md_sub_step_final.get());
-        auto t_avg_data = t_avg_data_c;
-        if (use_b_ct) {
-            t_avg_data = tl.AddTask(t_avg_data_c, WeightedSumDataFace,
-                                    std::vector<MetadataFlag>({Metadata::Independent, Metadata::Face}),
-                                    md_sub_step_init.get(), md_full_step_init.get(),
-                                    integrator->gam0[stage-1], integrator->gam1[stage-1],
-                                    md_sub_step_final.get());
-        }
-        // apply du/dt to the result
-        auto t_update_c = tl.AddTask(t_avg_data, Update::WeightedSumData<std::vector<MetadataFlag>, MeshData<Real>>,
-                                    std::vector<MetadataFlag>({Metadata::Independent, Metadata::Cell}),
-                                    md_sub_step_final.get(), md_flux_src.get(),
-                                    1.0, integrator->beta[stage-1] * integrator->dt,
-                                    md_sub_step_final.get());
-        auto t_update = t_update_c;
-        if (use_b_ct) {
-            t_update = tl.AddTask(t_update_c, WeightedSumDataFace,
-                                    std::vector<MetadataFlag>({Metadata::Independent, Metadata::Face}),
-                                    md_sub_step_final.get(), md_flux_src.get(),
-                                    1.0, integrator->beta[stage-1] * integrator->dt,
-                                    md_sub_step_final.get());
-        }
 
         // UtoP needs a guess in order to converge, so we copy in sc0
         // (but only the fluid primitives!)  Copying and syncing ensures that solves of the same zone
         // on adjacent ranks are seeded with the same value, which keeps them (more) similar
+        // (Under low-storage stepping, intermediate stages are updated in place and already hold it)
         auto t_copy_prims = t_update;
-        if (integrator->nstages > 1) {
+        if (integrator->nstages > 1 && md_sub_step_init != md_sub_step_final) {
             t_copy_prims = tl.AddTask(t_none, Copy<MeshData<Real>>, std::vector<MetadataFlag>({Metadata::GetUserFlag("HD"), Metadata::GetUserFlag("Primitive")}),
                                                 md_sub_step_init.get(), md_sub_step_final.get());
         }
 
-        KHARMADriver::AddBoundarySync(t_copy_prims | t_update, tl, md_sync);
+        // If we're not exchanging the primitives, exchange the initial guess they imply instead
+        auto t_seed = t_copy_prims | t_update;
+        if (compact_seed) {
+            t_seed = tl.AddTask(t_copy_prims | t_update, Inverter::MeshFillSeed, md_sub_step_final.get());
+        }
+
+        TaskID t_send;
+        KHARMADriver::AddBoundarySync(t_seed, tl, md_exchange, &t_send);
+
+        // Nothing in the interior depends on the incoming ghost zones, so invert it now, while
+        // we wait on them. Wait for our own boundaries to be sent first, so neighbors aren't held up
+        if (overlap_comms) {
+            tl.AddTask(t_send | t_seed, Packages::MeshUtoP, md_sub_step_final.get(), IndexDomain::interior, false);
+        }
     }
 
     EndFlag();
@@ -229,9 +294,9 @@ TaskCollection KHARMADriver::MakeDefaultTaskCollection(BlockList_t &blocks, int
     TaskRegion &fix_region = tc.AddRegion(num_partitions);
     for (int i = 0; i < num_partitions; i++) {
         auto &tl = fix_region[i];
-        auto &md_sub_step_init  = pmesh->mesh_data.GetOrAdd(integrator->stage_name[stage-1], i);
-        auto &md_sub_step_final = pmesh->mesh_data.GetOrAdd(integrator->stage_name[stage], i);
-        auto &md_sync = pmesh->mesh_data.AddShallow("sync"+integrator->stage_name[stage]+std::to_string(i), md_sub_step_final, sync_vars);
+        auto &md_sub_step_init  = stage_md[i].sub_step_init;
+        auto &md_sub_step_final = stage_md[i].sub_step_final;
+        auto &md_sync           = stage_md[i].sync;
 
         // At this point, we've sync'd all internal boundaries using the conserved
         // variables. The physical boundaries (pole, inner/outer) are trickier,
@@ -243,13 +308,21 @@ TaskCollection KHARMADriver::MakeDefaultTaskCollection(BlockList_t &blocks, int
         // This relies on the primitives being calculated identically in MPI boundaries, vs their corresponding
         // physical zones in the adjacent mesh block.  To ensure this, we seed the solver with the same values
         // in each case, by synchronizing them along with the conserved values above.
-        auto t_utop = tl.AddTask(t_none, Packages::MeshUtoP, md_sub_step_final.get(), IndexDomain::entire, false);
-        // As soon as we have primitive variables, apply floors
-        auto t_floors = tl.AddTask(t_utop, Packages::MeshApplyFloors, md_sub_step_final.get(), IndexDomain::entire);
-
-        // Then, fix any inversions which failed. Fixups average the adjacent zones, so we want to work from
-        // post-floor data. Floors are re-applied after fixups.
-        auto t_fix_p = tl.AddTask(t_floors, Inverter::MeshFixUtoP, md_sub_step_final.get());
+        TaskID t_fix_p;
+        if (fused_utop) {
+            // All three steps below, in one pass where possible
+            t_fix_p = tl.AddTask(t_none, Inverter::MeshUtoPFloorsFix, md_sub_step_final.get());
+        } else {
+            // If we inverted the interior during the exchange, just finish the MPI ghost zones
+            auto t_utop = (overlap_comms) ? tl.AddTask(t_none, Packages::MeshUtoPGhosts, md_sub_step_final.get())
+                                          : tl.AddTask(t_none, Packages::MeshUtoP, md_sub_step_final.get(), IndexDomain::entire, false);
+            // As soon as we have primitive variables, apply floors
+            auto t_floors = tl.AddTask(t_utop, Packages::MeshApplyFloors, md_sub_step_final.get(), IndexDomain::entire);
+
+            // Then, fix any inversions which failed. Fixups average the adjacent zones, so we want to work from
+            // post-floor data. Floors are re-applied after fixups.
+            t_fix_p = tl.AddTask(t_floors, Inverter::MeshFixUtoP, md_sub_step_final.get());
+        }
 
         // Domain (non-internal) boundary conditions:
         // This is a parthenon call, but in spherical coordinates it will call the KHARMA functions in
@@ -320,9 +393,7 @@ TaskCollection KHARMADriver::MakeDefaultTaskCollection(BlockList_t &blocks, int
     const auto &two_sync = pkgs.at("Driver")->Param<bool>("two_sync");
     if (two_sync) {
         for (int i = 0; i < num_partitions; i++) {
-            auto &md_sub_step_final = pmesh->mesh_data.GetOrAdd(integrator->stage_name[stage], i);
-            auto &md_sync = pmesh->mesh_data.AddShallow("sync"+integrator->stage_name[stage]+std::to_string(i), md_sub_step_final, sync_vars);
-            KHARMADriver::AddFullSyncRegion(tc, md_sync);
+            KHARMADriver::AddFullSyncRegion(tc, stage_md[i].sync);
         }
     }
 
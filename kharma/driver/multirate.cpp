@@ -0,0 +1,212 @@
+
+/* 
+ *  File: multirate.cpp
+ *  
+ *  BSD 3-Clause License
+ *  
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *  
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *  
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *  
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "multirate.hpp"
+
+#include "kharma.hpp"
+#include "kharma_driver.hpp"
+
+using namespace parthenon;
+
+std::shared_ptr<KHARMAPackage> Multirate::Initialize(ParameterInput *pin, std::shared_ptr<Packages_t>& packages)
+{
+    Flag("Initializing Multirate");
+    auto pkg = std::make_shared<KHARMAPackage>("Multirate");
+    Params &params = pkg->AllParams();
+
+    // Highest bin a block can be placed in, i.e. blocks step at most 2^max_level times as
+    // far as the block setting the global timestep.
+    int max_level = pin->GetOrAddInteger("driver", "multirate_max_level", 3);
+    if (max_level < 0 || max_level > 16)
+        throw std::invalid_argument("Multi-rate max level must be between 0 and 16!");
+    params.Add("max_level", max_level);
+
+    // Refluxing only covers cell-centered conserved variables with fluxes, and the stepping
+    // is only written for the default driver's order of operations
+    if (packages->Get("Driver")->Param<DriverType>("type") != DriverType::kharma)
+        throw std::invalid_argument("Multi-rate stepping is only implemented for the KHARMA driver!");
+    auto& all_pkgs = packages->AllPackages();
+    if (all_pkgs.count("B_FluxCT") || all_pkgs.count("B_CT") || all_pkgs.count("B_CD") || all_pkgs.count("B_Cleanup"))
+        throw std::invalid_argument("Multi-rate stepping does not support evolving a magnetic field!");
+    if (pin->GetOrAddString("parthenon/mesh", "refinement", "none") != "none")
+        throw std::invalid_argument("Multi-rate stepping does not support mesh refinement!");
+
+    // One register per direction, each holding every variable with fluxes
+    int nvar = KHARMA::PackDimension(packages.get(), Metadata::WithFluxes);
+    std::vector<MetadataFlag> flags_reg = {Metadata::Real, Metadata::Cell, Metadata::Derived, Metadata::OneCopy, Metadata::FillGhost};
+    Metadata m_reg = Metadata(flags_reg, std::vector<int>({nvar}));
+    pkg->AddField("Multirate.F1", m_reg);
+    pkg->AddField("Multirate.F2", m_reg);
+    pkg->AddField("Multirate.F3", m_reg);
+    // The bin of each block, constant over the block.  Exchanged so each block knows its neighbors' bins
+    Metadata m_bin = Metadata(flags_reg);
+    pkg->AddField("Multirate.bin", m_bin);
+
+    EndFlag();
+    return pkg;
+}
+
+TaskStatus Multirate::ResetRegisters(MeshData<Real> *md, const int level)
+{
+    auto pmb0 = md->GetBlockData(0)->GetBlockPointer();
+
+    auto R = md->PackVariables(std::vector<std::string>{"Multirate.F1", "Multirate.F2", "Multirate.F3"});
+    auto bin = md->PackVariables(std::vector<std::string>{"Multirate.bin"});
+
+    const IndexRange ib = md->GetBoundsI(IndexDomain::entire);
+    const IndexRange jb = md->GetBoundsJ(IndexDomain::entire);
+    const IndexRange kb = md->GetBoundsK(IndexDomain::entire);
+    const IndexRange block = IndexRange{0, R.GetDim(5)-1};
+    const IndexRange vars = IndexRange{0, R.GetDim(4)-1};
+
+    pmb0->par_for("multirate_reset", block.s, block.e, vars.s, vars.e, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+        KOKKOS_LAMBDA (const int &b, const int &v, const int &k, const int &j, const int &i) {
+            R(b, v, k, j, i) = 0.;
+            if (v == 0) bin(b, 0, k, j, i) = level;
+        }
+    );
+
+    return TaskStatus::complete;
+}
+
+TaskStatus Multirate::AccumulateFluxes(MeshData<Real> *md, const Real weight)
+{
+    auto pmb0 = md->GetBlockData(0)->GetBlockPointer();
+    const int ndim = pmb0->pmy_mesh->ndim;
+
+    auto& U = md->PackVariablesAndFluxes(std::vector<MetadataFlag>{Metadata::WithFluxes});
+    auto R1 = md->PackVariables(std::vector<std::string>{"Multirate.F1"});
+    auto R2 = md->PackVariables(std::vector<std::string>{"Multirate.F2"});
+    auto R3 = md->PackVariables(std::vector<std::string>{"Multirate.F3"});
+
+    const IndexRange ib = md->GetBoundsI(IndexDomain::interior);
+    const IndexRange jb = md->GetBoundsJ(IndexDomain::interior);
+    const IndexRange kb = md->GetBoundsK(IndexDomain::interior);
+    const IndexRange block = IndexRange{0, U.GetDim(5)-1};
+    const IndexRange vars = IndexRange{0, U.GetDim(4)-1};
+
+    // Only the block boundary faces are ever needed, so we only record those
+    pmb0->par_for("multirate_accumulate_x1", block.s, block.e, vars.s, vars.e, kb.s, kb.e, jb.s, jb.e,
+        KOKKOS_LAMBDA (const int &b, const int &v, const int &k, const int &j) {
+            R1(b, v, k, j, ib.s) += weight * U(b).flux(X1DIR, v, k, j, ib.s);
+            R1(b, v, k, j, ib.e) += weight * U(b).flux(X1DIR, v, k, j, ib.e + 1);
+        }
+    );
+    if (ndim > 1) {
+        pmb0->par_for("multirate_accumulate_x2", block.s, block.e, vars.s, vars.e, kb.s, kb.e, ib.s, ib.e,
+            KOKKOS_LAMBDA (const int &b, const int &v, const int &k, const int &i) {
+                R2(b, v, k, jb.s, i) += weight * U(b).flux(X2DIR, v, k, jb.s, i);
+                R2(b, v, k, jb.e, i) += weight * U(b).flux(X2DIR, v, k, jb.e + 1, i);
+            }
+        );
+    }
+    if (ndim > 2) {
+        pmb0->par_for("multirate_accumulate_x3", block.s, block.e, vars.s, vars.e, jb.s, jb.e, ib.s, ib.e,
+            KOKKOS_LAMBDA (const int &b, const int &v, const int &j, const int &i) {
+                R3(b, v, kb.s, j, i) += weight * U(b).flux(X3DIR, v, kb.s, j, i);
+                R3(b, v, kb.e, j, i) += weight * U(b).flux(X3DIR, v, kb.e + 1, j, i);
+            }
+        );
+    }
+
+    return TaskStatus::complete;
+}
+
+TaskStatus Multirate::Reflux(MeshData<Real> *md)
+{
+    Flag("Reflux");
+    auto pmb0 = md->GetBlockData(0)->GetBlockPointer();
+    const int ndim = pmb0->pmy_mesh->ndim;
+
+    auto U = md->PackVariables(std::vector<MetadataFlag>{Metadata::WithFluxes});
+    auto R1 = md->PackVariables(std::vector<std::string>{"Multirate.F1"});
+    auto R2 = md->PackVariables(std::vector<std::string>{"Multirate.F2"});
+    auto R3 = md->PackVariables(std::vector<std::string>{"Multirate.F3"});
+    auto bin = md->PackVariables(std::vector<std::string>{"Multirate.bin"});
+
+    const IndexRange ib = md->GetBoundsI(IndexDomain::interior);
+    const IndexRange jb = md->GetBoundsJ(IndexDomain::interior);
+    const IndexRange kb = md->GetBoundsK(IndexDomain::interior);
+    const IndexRange block = IndexRange{0, U.GetDim(5)-1};
+    const IndexRange vars = IndexRange{0, U.GetDim(4)-1};
+
+    // Only faces shared with another block have a neighbor's register in the ghost zones.
+    // Everything else is a physical boundary, and keeps its own fluxes.
+    ParArray2D<int> shared_face("shared_face", md->NumBlocks(), BOUNDARY_NFACES);
+    auto shared_face_h = shared_face.GetHostMirror();
+    for (int b = 0; b < md->NumBlocks(); b++) {
+        auto pmb = md->GetBlockData(b)->GetBlockPointer();
+        for (int f = 0; f < BOUNDARY_NFACES; f++) {
+            shared_face_h(b, f) = (pmb->boundary_flag[f] == BoundaryFlag::block ||
+                                   pmb->boundary_flag[f] == BoundaryFlag::periodic);
+        }
+    }
+    shared_face.DeepCopy(shared_face_h);
+
+    // Blocks in a higher bin replace the flux they integrated through the face with the neighbor's,
+    // which was integrated over more, smaller steps.
+    pmb0->par_for("multirate_reflux_x1", block.s, block.e, vars.s, vars.e, kb.s, kb.e, jb.s, jb.e,
+        KOKKOS_LAMBDA (const int &b, const int &v, const int &k, const int &j) {
+            const auto& G = U.GetCoords(b);
+            if (shared_face(b, BoundaryFace::inner_x1) && bin(b, 0, k, j, ib.s - 1) < bin(b, 0, k, j, ib.s))
+                U(b, v, k, j, ib.s) += (R1(b, v, k, j, ib.s - 1) - R1(b, v, k, j, ib.s)) / G.Dxc<1>(ib.s);
+            if (shared_face(b, BoundaryFace::outer_x1) && bin(b, 0, k, j, ib.e + 1) < bin(b, 0, k, j, ib.e))
+                U(b, v, k, j, ib.e) -= (R1(b, v, k, j, ib.e + 1) - R1(b, v, k, j, ib.e)) / G.Dxc<1>(ib.e);
+        }
+    );
+    if (ndim > 1) {
+        pmb0->par_for("multirate_reflux_x2", block.s, block.e, vars.s, vars.e, kb.s, kb.e, ib.s, ib.e,
+            KOKKOS_LAMBDA (const int &b, const int &v, const int &k, const int &i) {
+                const auto& G = U.GetCoords(b);
+                if (shared_face(b, BoundaryFace::inner_x2) && bin(b, 0, k, jb.s - 1, i) < bin(b, 0, k, jb.s, i))
+                    U(b, v, k, jb.s, i) += (R2(b, v, k, jb.s - 1, i) - R2(b, v, k, jb.s, i)) / G.Dxc<2>(jb.s);
+                if (shared_face(b, BoundaryFace::outer_x2) && bin(b, 0, k, jb.e + 1, i) < bin(b, 0, k, jb.e, i))
+                    U(b, v, k, jb.e, i) -= (R2(b, v, k, jb.e + 1, i) - R2(b, v, k, jb.e, i)) / G.Dxc<2>(jb.e);
+            }
+        );
+    }
+    if (ndim > 2) {
+        pmb0->par_for("multirate_reflux_x3", block.s, block.e, vars.s, vars.e, jb.s, jb.e, ib.s, ib.e,
+            KOKKOS_LAMBDA (const int &b, const int &v, const int &j, const int &i) {
+                const auto& G = U.GetCoords(b);
+                if (shared_face(b, BoundaryFace::inner_x3) && bin(b, 0, kb.s - 1, j, i) < bin(b, 0, kb.s, j, i))
+                    U(b, v, kb.s, j, i) += (R3(b, v, kb.s - 1, j, i) - R3(b, v, kb.s, j, i)) / G.Dxc<3>(kb.s);
+                if (shared_face(b, BoundaryFace::outer_x3) && bin(b, 0, kb.e + 1, j, i) < bin(b, 0, kb.e, j, i))
+                    U(b, v, kb.e, j, i) -= (R3(b, v, kb.e + 1, j, i) - R3(b, v, kb.e, j, i)) / G.Dxc<3>(kb.e);
+            }
+        );
+    }
+
+    EndFlag();
+    return TaskStatus::complete;
+}
@@ -0,0 +1,78 @@
+
+/* 
+ *  File: multirate.hpp
+ *  
+ *  BSD 3-Clause License
+ *  
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *  
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *  
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *  
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include "decs.hpp"
+#include "types.hpp"
+
+/**
+ * Multi-rate ("local") time stepping.
+ *
+ * MeshBlocks are sorted into bins by their local CFL limit, with bin L stepping at 2^L times the
+ * global minimum timestep.  The driver subcycles the inner (lower) bins, holding the outer blocks fixed
+ * until their own step is due.  See KHARMADriver::MultirateStep for the stepping itself.
+ *
+ * In order to remain conservative, each block keeps a register of the time-integrated fluxes through
+ * each of its faces over the global step.  At the end of the step, blocks which took fewer, larger steps
+ * than a neighbor replace their own integrated flux through the shared face with the neighbor's, as with
+ * Berger-Colella refluxing for refined meshes.
+ *
+ * The registers are cell-centered: the flux integrated through a block's lower face is stored in its first
+ * interior zone, and through its upper face in its last interior zone.  Thus, a normal ghost zone exchange
+ * delivers each neighbor's register to the ghost zones adjacent to the face it shares with us.
+ */
+namespace Multirate {
+/**
+ * Initialize the registers and bin field.  Must be loaded after all packages with fluxes
+ */
+std::shared_ptr<KHARMAPackage> Initialize(ParameterInput *pin, std::shared_ptr<Packages_t>& packages);
+
+/**
+ * Record the bin of each block in 'md', and zero its flux registers.  Called at the start of each global step.
+ */
+TaskStatus ResetRegisters(MeshData<Real> *md, const int level);
+
+/**
+ * Add the fluxes through each block boundary face to the registers, with weight 'weight'.
+ * For an RK stage, this is the stage's total contribution to the final state, times the block's dt.
+ */
+TaskStatus AccumulateFluxes(MeshData<Real> *md, const Real weight);
+
+/**
+ * Correct conserved variables in zones bordering blocks in lower bins, replacing the flux we integrated
+ * through each face with the neighbor's.  Requires the registers and bins to have been exchanged.
+ */
+TaskStatus Reflux(MeshData<Real> *md);
+
+}
@@ -0,0 +1,344 @@
+
+/* 
+ *  File: multirate_step.cpp
+ *  
+ *  BSD 3-Clause License
+ *  
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *  
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *  
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *  
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "kharma_driver.hpp"
+
+#include "boundaries.hpp"
+#include "electrons.hpp"
+#include "flux.hpp"
+#include "grmhd.hpp"
+#include "inverter.hpp"
+#include "kharma.hpp"
+#include "multirate.hpp"
+
+#include <parthenon/parthenon.hpp>
+#include <interface/update.hpp>
+
+std::shared_ptr<MeshData<Real>> &KHARMADriver::MultirateData(const std::string &label, const int level)
+{
+    auto &cache = mr_data[level];
+    if (!cache.count(label)) {
+        BlockList_t blocks;
+        for (int b = 0; b < pmesh->block_list.size(); b++)
+            if (mr_level[b] == level) blocks.push_back(pmesh->block_list[b]);
+        auto md = std::make_shared<MeshData<Real>>(label);
+        md->Set(blocks, pmesh);
+        cache[label] = md;
+    }
+    return cache[label];
+}
+
+TaskListStatus KHARMADriver::MultirateStep()
+{
+    Flag("MultirateStep");
+    auto& pkgs = pmesh->packages.AllPackages();
+    const int max_level = pkgs.at("Multirate")->Param<int>("max_level");
+    const Real cfl = pkgs.at("GRMHD")->Param<Real>("cfl");
+
+    // Allocate the stage containers, as MakeDefaultTaskCollection would
+    pmesh->mesh_data.Add("dUdt");
+    for (int i = 1; i < integrator->nstages; i++)
+        pmesh->mesh_data.Add(integrator->stage_name[i]);
+
+    // Sort blocks into bins by the crossing time from their last step.  tm.dt is the global
+    // minimum of cfl * crossing time (or less), so a block in bin L can safely take steps of 2^L * tm.dt.
+    // There are no crossing times before the first step, so everything starts in bin 0
+    const int nblocks = pmesh->block_list.size();
+    std::vector<int> level(nblocks, 0), gids(nblocks);
+    int lmin = max_level, lmax = 0;
+    for (int b = 0; b < nblocks; b++) {
+        auto &pmb = pmesh->block_list[b];
+        gids[b] = pmb->gid;
+        if (tm.ncycle > 0) {
+            const Real ndt = cfl * GRMHD::MinCrossingTime(pmb->meshblock_data.Get().get());
+            if (std::isfinite(ndt) && ndt > tm.dt)
+                level[b] = std::min((int) std::floor(std::log2(ndt / tm.dt)), max_level);
+        }
+        lmin = std::min(lmin, level[b]);
+        lmax = std::max(lmax, level[b]);
+    }
+#ifdef MPI_PARALLEL
+    PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &lmin, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD));
+    PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &lmax, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD));
+#endif
+    // If every block could take a larger step, tm.dt was set by some other limit (e.g. max_dt_increase).
+    // Respect it by keeping tm.dt as the step of the lowest occupied bin.
+    // Then, make sure the whole step doesn't take us past tlim
+    int nlevels = lmax - lmin + 1;
+    while (nlevels > 1 && tm.time + tm.dt * (1 << (nlevels - 1)) > tm.tlim)
+        nlevels--;
+    for (int b = 0; b < nblocks; b++)
+        level[b] = std::min(level[b] - lmin, nlevels - 1);
+
+    // Re-make the per-bin MeshData objects only if blocks changed bins (or moved)
+    if (level != mr_level || gids != mr_gids || (int) mr_data.size() != nlevels) {
+        mr_level = level;
+        mr_gids = gids;
+        mr_data.assign(nlevels, {});
+        mr_count.assign(nlevels, 0);
+        for (int b = 0; b < nblocks; b++)
+            mr_count[level[b]]++;
+    }
+
+    // Record bins and clear the flux registers for this step
+    for (int l = 0; l < nlevels; l++)
+        if (mr_count[l] > 0)
+            Multirate::ResetRegisters(MultirateData("base", l).get(), l);
+
+    // Packages applying operator-split sources at the end of the step take its length from dt_last
+    const Real dt_base = tm.dt;
+    const Real dt_step = dt_base * (1 << (nlevels - 1));
+    pkgs.at("Globals")->AllParams().Update<double>("dt_last", dt_step);
+
+    TaskListStatus status = TaskListStatus::complete;
+    for (int substep = 0; substep < (1 << (nlevels - 1)); substep++) {
+        for (int stage = 1; stage <= integrator->nstages; stage++) {
+            TaskCollection tc = MakeMultirateTaskCollection(stage, substep, dt_base);
+            status = tc.Execute();
+            if (status != TaskListStatus::complete) {
+                EndFlag();
+                return status;
+            }
+        }
+    }
+
+    TaskCollection tc = MakeRefluxTaskCollection();
+    status = tc.Execute();
+
+    // The driver advances tm.time by tm.dt after each step.  The next call to SetGlobalTimeStep
+    // will go back to the minimum over all blocks
+    tm.dt = dt_step;
+
+    EndFlag();
+    return status;
+}
+
+TaskCollection KHARMADriver::MakeMultirateTaskCollection(int stage, int substep, Real dt_base)
+{
+    TaskCollection tc;
+    const TaskID t_none(0);
+
+    auto& pkgs = pmesh->packages.AllPackages();
+    auto& driver_pkg   = pkgs.at("Driver")->AllParams();
+    const bool use_electrons = pkgs.count("Electrons");
+    const bool fused_utop = driver_pkg.Get<bool>("fused_utop");
+    const KReconstruction::Type& recon = driver_pkg.Get<KReconstruction::Type>("recon");
+    auto &sync_vars = SyncVars();
+
+    const int nlevels = mr_data.size();
+    // Whether bin l takes (part of) a step this substep
+    auto active = [substep](const int l) { return substep % (1 << l) == 0; };
+
+    // Contribution of this stage's fluxes to the final state of an RK step, per unit dt:
+    // later stages scale it by gam0 but don't otherwise change it
+    Real stage_weight = integrator->beta[stage-1];
+    for (int q = stage; q < integrator->nstages; q++)
+        stage_weight *= integrator->gam0[q];
+
+    Flag("MakeMultirateTaskCollection::fluxes");
+
+    // Flux region: one list per bin.  See MakeDefaultTaskCollection
+    TaskRegion &flux_region = tc.AddRegion(nlevels);
+    for (int l = 0; l < nlevels; l++) {
+        if (mr_count[l] == 0) continue;
+        auto &tl = flux_region[l];
+        auto &md_full_step_init = MultirateData("base", l);
+        auto &md_sub_step_init  = MultirateData(integrator->stage_name[stage - 1], l);
+        auto &md_sub_step_final = MultirateData(integrator->stage_name[stage], l);
+
+        if (!active(l)) {
+            // Present the state as of our last step to any neighbors which are stepping
+            // (the final stage writes to the base container, which already holds it)
+            if (stage < integrator->nstages) {
+                tl.AddTask(t_none, Copy<MeshData<Real>>, std::vector<MetadataFlag>({Metadata::Independent, Metadata::Cell}),
+                            md_full_step_init.get(), md_sub_step_final.get());
+                tl.AddTask(t_none, Copy<MeshData<Real>>, std::vector<MetadataFlag>({Metadata::GetUserFlag("Primitive")}),
+                            md_full_step_init.get(), md_sub_step_final.get());
+            }
+            continue;
+        }
+
+        const Real dt_level = dt_base * (1 << l);
+        auto &md_flux_src = MultirateData("dUdt", l);
+
+        TaskID t_start = t_none;
+        auto t_fluxes = KHARMADriver::AddFluxCalculations(t_start, tl, recon, md_sub_step_init.get());
+        auto t_fix_flux = tl.AddTask(t_fluxes, Packages::FixFlux, md_sub_step_init.get());
+
+        // Record what crossed our boundaries, for correcting neighbors in other bins
+        auto t_register = tl.AddTask(t_fix_flux, Multirate::AccumulateFluxes, md_sub_step_init.get(), stage_weight * dt_level);
+
+        auto t_flux_div = tl.AddTask(t_fix_flux, Update::FluxDivergence<MeshData<Real>>, md_sub_step_init.get(), md_flux_src.get());
+        auto t_sources = tl.AddTask(t_flux_div, Packages::AddSource, md_sub_step_init.get(), md_flux_src.get());
+
+        auto t_update = tl.AddTask(t_sources | t_register, StageUpdate, std::vector<MetadataFlag>({Metadata::Independent}),
+                                    md_sub_step_init.get(), md_full_step_init.get(), md_flux_src.get(),
+                                    integrator->gam0[stage-1], integrator->gam1[stage-1],
+                                    integrator->beta[stage-1] * dt_level,
+                                    md_sub_step_final.get());
+
+        // Seed UtoP with the last primitives, see MakeDefaultTaskCollection
+        if (integrator->nstages > 1) {
+            tl.AddTask(t_none, Copy<MeshData<Real>>, std::vector<MetadataFlag>({Metadata::GetUserFlag("HD"), Metadata::GetUserFlag("Primitive")}),
+                        md_sub_step_init.get(), md_sub_step_final.get());
+        }
+    }
+
+    EndFlag();
+    Flag("MakeMultirateTaskCollection::sync");
+
+    // Every block exchanges boundaries, so blocks which stepped see neighbors in any bin.
+    // Blocks which didn't step only hold the data for their next step.
+    const int num_partitions = pmesh->DefaultNumPartitions();
+    TaskRegion &sync_region = tc.AddRegion(num_partitions);
+    for (int i = 0; i < num_partitions; i++) {
+        auto &tl = sync_region[i];
+        auto &md_sub_step_final = pmesh->mesh_data.GetOrAdd(integrator->stage_name[stage], i);
+        auto &md_sync = pmesh->mesh_data.AddShallow("sync"+integrator->stage_name[stage]+std::to_string(i), md_sub_step_final, sync_vars);
+        auto t_start_recv = tl.AddTask(t_none, parthenon::StartReceiveBoundBufs<parthenon::BoundaryType::any>, md_sync);
+        KHARMADriver::AddBoundarySync(t_start_recv, tl, md_sync);
+    }
+
+    EndFlag();
+    Flag("MakeMultirateTaskCollection::fixes");
+
+    // Fix region, only for blocks which stepped.  See MakeDefaultTaskCollection
+    TaskRegion &fix_region = tc.AddRegion(nlevels);
+    for (int l = 0; l < nlevels; l++) {
+        if (mr_count[l] == 0 || !active(l)) continue;
+        auto &tl = fix_region[l];
+        auto &md_sub_step_init  = MultirateData(integrator->stage_name[stage - 1], l);
+        auto &md_sub_step_final = MultirateData(integrator->stage_name[stage], l);
+
+        TaskID t_fix_p;
+        if (fused_utop) {
+            t_fix_p = tl.AddTask(t_none, Inverter::MeshUtoPFloorsFix, md_sub_step_final.get());
+        } else {
+            auto t_utop = tl.AddTask(t_none, Packages::MeshUtoP, md_sub_step_final.get(), IndexDomain::entire, false);
+            auto t_floors = tl.AddTask(t_utop, Packages::MeshApplyFloors, md_sub_step_final.get(), IndexDomain::entire);
+            t_fix_p = tl.AddTask(t_floors, Inverter::MeshFixUtoP, md_sub_step_final.get());
+        }
+
+        auto t_set_bc = tl.AddTask(t_fix_p, parthenon::ApplyBoundaryConditionsOnCoarseOrFineMD, md_sub_step_final, false);
+
+        auto t_heat_electrons = t_set_bc;
+        if (use_electrons) {
+            t_heat_electrons = tl.AddTask(t_set_bc, Electrons::MeshApplyElectronHeating,
+                                          md_sub_step_init.get(), md_sub_step_final.get());
+        }
+
+        tl.AddTask(t_heat_electrons, Flux::MeshPtoU, md_sub_step_final.get(), IndexDomain::entire, false);
+    }
+
+    EndFlag();
+
+    return tc;
+}
+
+TaskCollection KHARMADriver::MakeRefluxTaskCollection()
+{
+    TaskCollection tc;
+    const TaskID t_none(0);
+
+    auto& pkgs = pmesh->packages.AllPackages();
+    auto& driver_pkg   = pkgs.at("Driver")->AllParams();
+    const bool fused_utop = driver_pkg.Get<bool>("fused_utop");
+    auto &sync_vars = SyncVars();
+    // The last stage of each step writes back to the base container
+    const std::string &final_name = integrator->stage_name[integrator->nstages];
+    const std::vector<std::string> register_vars = {"Multirate.F1", "Multirate.F2", "Multirate.F3", "Multirate.bin"};
+
+    Flag("MakeRefluxTaskCollection");
+
+    // Exchange flux registers, so each block sees its neighbors' integrated fluxes & bins in its ghost zones
+    const int num_partitions = pmesh->DefaultNumPartitions();
+    TaskRegion &register_region = tc.AddRegion(num_partitions);
+    for (int i = 0; i < num_partitions; i++) {
+        auto &tl = register_region[i];
+        auto &md_final = pmesh->mesh_data.GetOrAdd(final_name, i);
+        auto &md_registers = pmesh->mesh_data.AddShallow("multirate_registers"+std::to_string(i), md_final, register_vars);
+        auto t_start_recv = tl.AddTask(t_none, parthenon::StartReceiveBoundBufs<parthenon::BoundaryType::any>, md_registers);
+        KHARMADriver::AddBoundarySync(t_start_recv, tl, md_registers);
+    }
+
+    // Correct the conserved variables at bin interfaces, and recover primitives
+    TaskRegion &reflux_region = tc.AddRegion(num_partitions);
+    for (int i = 0; i < num_partitions; i++) {
+        auto &tl = reflux_region[i];
+        auto &md_final = pmesh->mesh_data.GetOrAdd(final_name, i);
+        auto t_reflux = tl.AddTask(t_none, Multirate::Reflux, md_final.get());
+        if (fused_utop) {
+            tl.AddTask(t_reflux, Inverter::MeshUtoPFloorsFix, md_final.get());
+        } else {
+            auto t_utop = tl.AddTask(t_reflux, Packages::MeshUtoP, md_final.get(), IndexDomain::entire, false);
+            auto t_floors = tl.AddTask(t_utop, Packages::MeshApplyFloors, md_final.get(), IndexDomain::entire);
+            tl.AddTask(t_floors, Inverter::MeshFixUtoP, md_final.get());
+        }
+    }
+
+    // Exchange the corrected zones
+    TaskRegion &sync_region = tc.AddRegion(num_partitions);
+    for (int i = 0; i < num_partitions; i++) {
+        auto &tl = sync_region[i];
+        auto &md_final = pmesh->mesh_data.GetOrAdd(final_name, i);
+        auto &md_sync = pmesh->mesh_data.AddShallow("sync"+final_name+std::to_string(i), md_final, sync_vars);
+        auto t_start_recv = tl.AddTask(t_none, parthenon::StartReceiveBoundBufs<parthenon::BoundaryType::any>, md_sync);
+        KHARMADriver::AddBoundarySync(t_start_recv, tl, md_sync);
+    }
+
+    // Finish the step as the last stage of MakeDefaultTaskCollection does, for the whole mesh at once
+    TaskRegion &fix_region = tc.AddRegion(num_partitions);
+    for (int i = 0; i < num_partitions; i++) {
+        auto &tl = fix_region[i];
+        auto &md_final = pmesh->mesh_data.GetOrAdd(final_name, i);
+        auto &md_sync = pmesh->mesh_data.AddShallow("sync"+final_name+std::to_string(i), md_final, sync_vars);
+
+        auto t_set_bc = tl.AddTask(t_none, parthenon::ApplyBoundaryConditionsOnCoarseOrFineMD, md_sync, false);
+        // Operator-split over the whole multi-rate step, see dt_last in MultirateStep
+        auto t_prim_source = tl.AddTask(t_set_bc, Packages::MeshApplyPrimSource, md_final.get());
+        auto t_ptou = tl.AddTask(t_prim_source, Flux::MeshPtoU, md_final.get(), IndexDomain::entire, false);
+        tl.AddTask(t_ptou, Update::EstimateTimestep<MeshData<Real>>, md_final.get());
+    }
+
+    if (driver_pkg.Get<bool>("two_sync")) {
+        for (int i = 0; i < num_partitions; i++) {
+            auto &md_final = pmesh->mesh_data.GetOrAdd(final_name, i);
+            auto &md_sync = pmesh->mesh_data.AddShallow("sync"+final_name+std::to_string(i), md_final, sync_vars);
+            KHARMADriver::AddFullSyncRegion(tc, md_sync);
+        }
+    }
+
+    EndFlag();
+
+    return tc;
+}
@@ -0,0 +1,88 @@
+
+/* 
+ *  File: multizone.cpp
+ *  
+ *  BSD 3-Clause License
+ *  
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *  
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *  
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *  
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "multizone.hpp"
+
+#include "kharma_driver.hpp"
+
+using namespace parthenon;
+
+std::shared_ptr<KHARMAPackage> Multizone::Initialize(ParameterInput *pin, std::shared_ptr<Packages_t>& packages)
+{
+    Flag("Initializing Multizone");
+    auto pkg = std::make_shared<KHARMAPackage>("Multizone");
+    Params &params = pkg->AllParams();
+
+    // Number of annuli, each spanning a factor of base^2 in radius and overlapping
+    // the next by a factor of base.  Together they span 1 < r < base^(nzones+1).
+    int nzones = pin->GetOrAddInteger("multizone", "nzones", 2);
+    if (nzones < 1)
+        throw std::invalid_argument("Multizone runs need at least one zone!");
+    params.Add("nzones", nzones);
+    Real base = pin->GetOrAddReal("multizone", "base", 8.);
+    if (base <= 1.)
+        throw std::invalid_argument("Multizone base must be greater than 1!");
+    params.Add("base", base);
+    // Simulation time to spend in each zone before moving on
+    Real zone_time = pin->GetReal("multizone", "zone_time");
+    if (zone_time <= 0.)
+        throw std::invalid_argument("Multizone zone_time must be positive!");
+    params.Add("zone_time", zone_time);
+
+    // The annuli are spherical shells
+    if (!pin->GetBoolean("coordinates", "spherical"))
+        throw std::invalid_argument("Multizone runs require spherical coordinates!");
+    // Stepping follows the default driver's order of operations, over a subset of blocks
+    if (packages->Get("Driver")->Param<DriverType>("type") != DriverType::kharma)
+        throw std::invalid_argument("Multizone runs are only implemented for the KHARMA driver!");
+    if (packages->AllPackages().count("B_CT"))
+        throw std::invalid_argument("Multizone runs do not support face-centered CT!");
+    if (packages->AllPackages().count("Multirate"))
+        throw std::invalid_argument("Multizone runs cannot also use multi-rate stepping!");
+    if (pin->GetOrAddString("parthenon/mesh", "refinement", "none") != "none")
+        throw std::invalid_argument("Multizone runs do not support mesh refinement!");
+
+    EndFlag();
+    return pkg;
+}
+
+bool Multizone::BlockInAnnulus(MeshBlock *pmb, const GReal r_in, const GReal r_out)
+{
+    const auto &bs = pmb->block_size;
+    const GReal Xnative[GR_DIM] = {0.,
+                                   (bs.xmin(X1DIR) + bs.xmax(X1DIR)) / 2,
+                                   (bs.xmin(X2DIR) + bs.xmax(X2DIR)) / 2,
+                                   (bs.xmin(X3DIR) + bs.xmax(X3DIR)) / 2};
+    const GReal r = pmb->coords.coords.r_of(Xnative);
+    return r > r_in && r < r_out;
+}
@@ -0,0 +1,75 @@
+
+/* 
+ *  File: multizone.hpp
+ *  
+ *  BSD 3-Clause License
+ *  
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *  
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *  
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *  
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include "decs.hpp"
+#include "types.hpp"
+
+/**
+ * In-process "multizone" stepping.
+ *
+ * A multizone run evolves only one annulus r_in < r < r_out of a large spherical domain at a time,
+ * cycling the annulus inward, then back outward, and so on.  Zone z covers base^z < r < base^(z+2),
+ * for z from nzones-1 down to 0.  Each zone is evolved for zone_time before moving on.
+ *
+ * Rather than restarting into a new mesh for each annulus, we keep the whole domain in memory and only step
+ * the MeshBlocks inside the current annulus.  Blocks outside it are frozen, and provide fixed boundary
+ * values to the annulus through the usual ghost zone exchange.  Thus the annulus edges should fall
+ * on MeshBlock boundaries: e.g., in exponential coordinates with a MeshBlock spanning each factor of base.
+ * See KHARMADriver::MultizoneStep.
+ */
+namespace Multizone {
+/**
+ * Read the zone schedule
+ */
+std::shared_ptr<KHARMAPackage> Initialize(ParameterInput *pin, std::shared_ptr<Packages_t>& packages);
+
+/**
+ * Index of the zone evolved during a given run, for runs counted from 0.
+ * Zones bounce back and forth: nzones-1, ..., 1, 0, 1, ..., nzones-1, ...
+ */
+inline int ZoneOfRun(const int run, const int nzones)
+{
+    if (nzones < 2) return 0;
+    const int period = 2 * (nzones - 1);
+    const int p = run % period;
+    return (p < nzones - 1) ? nzones - 1 - p : p - (nzones - 1);
+}
+
+/**
+ * Whether the center of MeshBlock pmb lies in the annulus r_in < r < r_out
+ */
+bool BlockInAnnulus(MeshBlock *pmb, const GReal r_in, const GReal r_out);
+
+}
@@ -0,0 +1,270 @@
+
+/* 
+ *  File: multizone_step.cpp
+ *  
+ *  BSD 3-Clause License
+ *  
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *  
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *  
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *  
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "kharma_driver.hpp"
+
+#include "boundaries.hpp"
+#include "electrons.hpp"
+#include "flux.hpp"
+#include "grmhd.hpp"
+#include "inverter.hpp"
+#include "kharma.hpp"
+#include "multizone.hpp"
+
+#include <parthenon/parthenon.hpp>
+#include <interface/update.hpp>
+
+std::shared_ptr<MeshData<Real>> &KHARMADriver::MultizoneData(const std::string &label, const bool active)
+{
+    auto &cache = mz_data[active];
+    if (!cache.count(label)) {
+        BlockList_t blocks;
+        for (int b = 0; b < pmesh->block_list.size(); b++)
+            if (mz_active[b] == active) blocks.push_back(pmesh->block_list[b]);
+        auto md = std::make_shared<MeshData<Real>>(label);
+        md->Set(blocks, pmesh);
+        cache[label] = md;
+    }
+    return cache[label];
+}
+
+TaskListStatus KHARMADriver::MultizoneStep()
+{
+    Flag("MultizoneStep");
+    auto& pkgs = pmesh->packages.AllPackages();
+    auto& mz_pars = pkgs.at("Multizone")->AllParams();
+    const int nzones = mz_pars.Get<int>("nzones");
+    const Real base = mz_pars.Get<Real>("base");
+    const Real zone_time = mz_pars.Get<Real>("zone_time");
+    const int verbose = pkgs.at("Globals")->Param<int>("verbose");
+
+    // Allocate the stage containers, as MakeDefaultTaskCollection would
+    pmesh->mesh_data.Add("dUdt");
+    for (int i = 1; i < integrator->nstages; i++)
+        pmesh->mesh_data.Add(integrator->stage_name[i]);
+    if (pkgs.count("Current")) {
+        pmesh->mesh_data.Add("preserve");
+        Copy<MeshData<Real>>({Metadata::Cell}, pmesh->mesh_data.Get().get(), pmesh->mesh_data.Get("preserve").get());
+    }
+
+    // Steps are trimmed to end on zone boundaries, so which run we're in follows from the time.
+    // Allow for roundoff in tm.time landing on the boundary
+    const int run = (int) m::floor(tm.time / zone_time + 1.e-9);
+
+    const int nblocks = pmesh->block_list.size();
+    std::vector<int> gids(nblocks);
+    for (int b = 0; b < nblocks; b++)
+        gids[b] = pmesh->block_list[b]->gid;
+
+    if (run != mz_run || gids != mz_gids) {
+        const int zone = Multizone::ZoneOfRun(run, nzones);
+        const GReal r_in = m::pow(base, zone);
+        const GReal r_out = m::pow(base, zone + 2);
+
+        mz_active.assign(nblocks, 0);
+        mz_count[0] = mz_count[1] = 0;
+        for (int b = 0; b < nblocks; b++) {
+            mz_active[b] = Multizone::BlockInAnnulus(pmesh->block_list[b].get(), r_in, r_out);
+            mz_count[mz_active[b]]++;
+        }
+        mz_gids = gids;
+        mz_data[0].clear();
+        mz_data[1].clear();
+
+        int n_active = mz_count[1];
+#ifdef MPI_PARALLEL
+        PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &n_active, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD));
+#endif
+        if (n_active == 0)
+            throw std::runtime_error("No MeshBlocks in multizone annulus! Make sure blocks are smaller than an annulus.");
+
+        // Frozen blocks still exchange boundaries from every stage container, so they must all hold their final state
+        if (mz_count[0] > 0) {
+            auto &md_frozen = MultizoneData("base", false);
+            for (int i = 1; i < integrator->nstages; i++) {
+                auto &md_stage = MultizoneData(integrator->stage_name[i], false);
+                Copy<MeshData<Real>>({Metadata::Independent, Metadata::Cell}, md_frozen.get(), md_stage.get());
+                Copy<MeshData<Real>>({Metadata::GetUserFlag("Primitive")}, md_frozen.get(), md_stage.get());
+            }
+        }
+
+        if (run != mz_run) {
+            // Take whatever is in the ghost zones as the Dirichlet conditions from here,
+            // as restarting into the annulus would
+            auto &md_full = pmesh->mesh_data.Get();
+            KBoundaries::FreezeDirichlet(md_full);
+
+            // The last zone's timestep has nothing to do with this one's, so start over from the light crossing time
+            Real dt_light = std::numeric_limits<Real>::max();
+            for (int b = 0; b < nblocks; b++)
+                if (mz_active[b])
+                    dt_light = m::min(dt_light, GRMHD::EstimateRadiativeTimestep(pmesh->block_list[b]->meshblock_data.Get().get()));
+#ifdef MPI_PARALLEL
+            PARTHENON_MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &dt_light, 1, MPI_PARTHENON_REAL, MPI_MIN, MPI_COMM_WORLD));
+#endif
+            tm.dt = dt_light;
+
+            if (verbose > 0 && MPIRank0()) {
+                std::cout << "Multizone run " << run << ": zone " << zone << ", " << r_in << " < r < " << r_out
+                          << " (" << n_active << " blocks)" << std::endl;
+            }
+        }
+        mz_run = run;
+    }
+
+    // Don't step past the end of the zone
+    const Real t_switch = (run + 1) * zone_time;
+    if (tm.time + tm.dt > t_switch)
+        tm.dt = t_switch - tm.time;
+    integrator->dt = tm.dt;
+
+    TaskListStatus status = TaskListStatus::complete;
+    for (int stage = 1; stage <= integrator->nstages; stage++) {
+        TaskCollection tc = MakeMultizoneTaskCollection(stage);
+        status = tc.Execute();
+        if (status != TaskListStatus::complete) break;
+    }
+
+    EndFlag();
+    return status;
+}
+
+TaskCollection KHARMADriver::MakeMultizoneTaskCollection(int stage)
+{
+    TaskCollection tc;
+    const TaskID t_none(0);
+
+    auto& pkgs = pmesh->packages.AllPackages();
+    auto& driver_pkg   = pkgs.at("Driver")->AllParams();
+    const bool use_electrons = pkgs.count("Electrons");
+    const bool fused_utop = driver_pkg.Get<bool>("fused_utop");
+    const KReconstruction::Type& recon = driver_pkg.Get<KReconstruction::Type>("recon");
+    auto &sync_vars = SyncVars();
+
+    // Whether this rank has any blocks in the annulus
+    const bool stepping = mz_count[1] > 0;
+
+    Flag("MakeMultizoneTaskCollection::fluxes");
+
+    // Flux region: see MakeDefaultTaskCollection
+    TaskRegion &flux_region = tc.AddRegion(1);
+    if (stepping) {
+        auto &tl = flux_region[0];
+        auto &md_full_step_init = MultizoneData("base", true);
+        auto &md_sub_step_init  = MultizoneData(integrator->stage_name[stage - 1], true);
+        auto &md_sub_step_final = MultizoneData(integrator->stage_name[stage], true);
+        auto &md_flux_src       = MultizoneData("dUdt", true);
+
+        TaskID t_start = t_none;
+        auto t_fluxes = KHARMADriver::AddFluxCalculations(t_start, tl, recon, md_sub_step_init.get());
+        auto t_fix_flux = tl.AddTask(t_fluxes, Packages::FixFlux, md_sub_step_init.get());
+        auto t_flux_div = tl.AddTask(t_fix_flux, Update::FluxDivergence<MeshData<Real>>, md_sub_step_init.get(), md_flux_src.get());
+        auto t_sources = tl.AddTask(t_flux_div, Packages::AddSource, md_sub_step_init.get(), md_flux_src.get());
+
+        tl.AddTask(t_sources, StageUpdate, std::vector<MetadataFlag>({Metadata::Independent}),
+                                    md_sub_step_init.get(), md_full_step_init.get(), md_flux_src.get(),
+                                    integrator->gam0[stage-1], integrator->gam1[stage-1],
+                                    integrator->beta[stage-1] * integrator->dt,
+                                    md_sub_step_final.get());
+
+        if (integrator->nstages > 1) {
+            tl.AddTask(t_none, Copy<MeshData<Real>>, std::vector<MetadataFlag>({Metadata::GetUserFlag("HD"), Metadata::GetUserFlag("Primitive")}),
+                        md_sub_step_init.get(), md_sub_step_final.get());
+        }
+    }
+
+    EndFlag();
+    Flag("MakeMultizoneTaskCollection::sync");
+
+    // Every block exchanges boundaries, so the annulus sees the frozen values around it
+    const int num_partitions = pmesh->DefaultNumPartitions();
+    TaskRegion &sync_region = tc.AddRegion(num_partitions);
+    for (int i = 0; i < num_partitions; i++) {
+        auto &tl = sync_region[i];
+        auto &md_sub_step_final = pmesh->mesh_data.GetOrAdd(integrator->stage_name[stage], i);
+        auto &md_sync = pmesh->mesh_data.AddShallow("sync"+integrator->stage_name[stage]+std::to_string(i), md_sub_step_final, sync_vars);
+        auto t_start_recv = tl.AddTask(t_none, parthenon::StartReceiveBoundBufs<parthenon::BoundaryType::any>, md_sync);
+        KHARMADriver::AddBoundarySync(t_start_recv, tl, md_sync);
+    }
+
+    EndFlag();
+    Flag("MakeMultizoneTaskCollection::fixes");
+
+    // Fix region: see MakeDefaultTaskCollection
+    TaskRegion &fix_region = tc.AddRegion(1);
+    if (stepping) {
+        auto &tl = fix_region[0];
+        auto &md_sub_step_init  = MultizoneData(integrator->stage_name[stage - 1], true);
+        auto &md_sub_step_final = MultizoneData(integrator->stage_name[stage], true);
+
+        TaskID t_fix_p;
+        if (fused_utop) {
+            t_fix_p = tl.AddTask(t_none, Inverter::MeshUtoPFloorsFix, md_sub_step_final.get());
+        } else {
+            auto t_utop = tl.AddTask(t_none, Packages::MeshUtoP, md_sub_step_final.get(), IndexDomain::entire, false);
+            auto t_floors = tl.AddTask(t_utop, Packages::MeshApplyFloors, md_sub_step_final.get(), IndexDomain::entire);
+            t_fix_p = tl.AddTask(t_floors, Inverter::MeshFixUtoP, md_sub_step_final.get());
+        }
+
+        auto t_set_bc = tl.AddTask(t_fix_p, parthenon::ApplyBoundaryConditionsOnCoarseOrFineMD, md_sub_step_final, false);
+
+        auto t_prim_source = t_set_bc;
+        if (stage == integrator->nstages) {
+            t_prim_source = tl.AddTask(t_set_bc, Packages::MeshApplyPrimSource, md_sub_step_final.get());
+        }
+        auto t_heat_electrons = t_prim_source;
+        if (use_electrons) {
+            t_heat_electrons = tl.AddTask(t_prim_source, Electrons::MeshApplyElectronHeating,
+                                          md_sub_step_init.get(), md_sub_step_final.get());
+        }
+
+        auto t_ptou = tl.AddTask(t_heat_electrons, Flux::MeshPtoU, md_sub_step_final.get(), IndexDomain::entire, false);
+
+        // Only blocks in the annulus limit the step
+        if (stage == integrator->nstages) {
+            tl.AddTask(t_ptou, Update::EstimateTimestep<MeshData<Real>>, md_sub_step_final.get());
+        }
+    }
+
+    EndFlag();
+
+    if (driver_pkg.Get<bool>("two_sync")) {
+        for (int i = 0; i < num_partitions; i++) {
+            auto &md_sub_step_final = pmesh->mesh_data.GetOrAdd(integrator->stage_name[stage], i);
+            auto &md_sync = pmesh->mesh_data.AddShallow("sync"+integrator->stage_name[stage]+std::to_string(i), md_sub_step_final, sync_vars);
+            KHARMADriver::AddFullSyncRegion(tc, md_sync);
+        }
+    }
+
+    return tc;
+}
@@ -98,16 +98,10 @@ TaskCollection KHARMADriver::MakeSimpleTaskCollection(BlockList_t &blocks, int s
 
         // Perform the update using the source term
         // Add any proportion of the step start required by the integrator (e.g., RK2)
-        auto t_avg_data = tl.AddTask(t_sources, Update::WeightedSumData<std::vector<MetadataFlag>, MeshData<Real>>,
-                                    std::vector<MetadataFlag>({Metadata::Independent}),
-                                    md_sub_step_init.get(), md_full_step_init.get(),
+        auto t_update = tl.AddTask(t_sources, StageUpdate, std::vector<MetadataFlag>({Metadata::Independent}),
+                                    md_sub_step_init.get(), md_full_step_init.get(), md_flux_src.get(),
                                     integrator->gam0[stage-1], integrator->gam1[stage-1],
-                                    md_sub_step_final.get());
-        // apply du/dt to the result
-        auto t_update = tl.AddTask(t_sources, Update::WeightedSumData<std::vector<MetadataFlag>, MeshData<Real>>,
-                                    std::vector<MetadataFlag>({Metadata::Independent}),
-                                    md_sub_step_final.get(), md_flux_src.get(),
-                                    1.0, integrator->beta[stage-1] * integrator->dt,
+                                    integrator->beta[stage-1] * integrator->dt,
                                     md_sub_step_final.get());
 
         // UtoP needs a guess in order to converge, so we copy in md_sub_step_init
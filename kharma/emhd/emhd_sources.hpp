@@ -49,8 +49,8 @@ namespace EMHD {
 /**
  * Implicit source terms for EMHD, evaluated during implicit step calculation
  */
-template<typename Local>
-KOKKOS_INLINE_FUNCTION void implicit_sources(const GRCoordinates& G, const Local& P, const Local& P_tau, const VarMap& m_p,
+template<typename Local, typename Local2>
+KOKKOS_INLINE_FUNCTION void implicit_sources(const GRCoordinates& G, const Local& P, const Local2& P_tau, const VarMap& m_p,
                                              const Real& gam, const int& k, const int& j, const int& i,
                                              const EMHD_parameters& emhd_params_tau,
                                              Real& dUq, Real& dUdP)
@@ -68,9 +68,9 @@ KOKKOS_INLINE_FUNCTION void implicit_sources(const GRCoordinates& G, const Local
  * EMHD source terms requiring time derivatives, used to evaluate residual
  * gamma, j, i,
  */
-template<typename Local>
+template<typename Local, typename Local2>
 KOKKOS_INLINE_FUNCTION void time_derivative_sources(const GRCoordinates& G, const Local& P_new,
-                                                    const Local& P_old, const Local& P,
+                                                    const Local2& P_old, const Local2& P,
                                                     const VarMap& m_p, const EMHD_parameters& emhd_params,
                                                     const Real& gam, const Real& dt, 
                                                     const int & k, const int& j, const int& i,
@@ -68,7 +68,9 @@ KOKKOS_INLINE_FUNCTION void gradient_calc(const GRCoordinates& G, const Variable
         grad_ucov[3][mu] = (do_3d) ? slope_calc<recon, X3DIR>(G, Temps, uvec_index + mu, k, j, i) : 0.;
     }
     // TODO skip this if flat space?
-    DLOOP3 grad_ucov[mu][nu] -= G.conn(j, i, lam, mu, nu) * Temps(uvec_index + lam, k, j, i);
+    Real conn[GR_DIM][GR_DIM][GR_DIM];
+    G.conn(j, i, conn);
+    DLOOP3 grad_ucov[mu][nu] -= conn[lam][mu][nu] * Temps(uvec_index + lam, k, j, i);
 
     // Compute temperature gradient
     // Time derivative component is computed in time_derivative_sources
@@ -56,18 +56,21 @@ std::shared_ptr<KHARMAPackage> Flux::Initialize(ParameterInput *pin, std::shared
     if (packages->Get("Globals")->Param<int>("verbose") > 2)
         std::cout << "Allocating fluxes for " << nvar << " variables" << std::endl;
     // TODO optionally move all these to faces? Not important yet, & faces have no output, more memory
-    std::vector<MetadataFlag> flags_flux = {Metadata::Real, Metadata::Cell, Metadata::Derived, Metadata::OneCopy};
-    Metadata m = Metadata(flags_flux, s_flux);
-    pkg->AddField("Flux.Pr", m);
-    pkg->AddField("Flux.Pl", m);
-    pkg->AddField("Flux.Ur", m);
-    pkg->AddField("Flux.Ul", m);
-    pkg->AddField("Flux.Fr", m);
-    pkg->AddField("Flux.Fl", m);
+    // The fused flux kernel keeps face states in scratch, so doesn't need these
+    if (!packages->Get("Driver")->Param<bool>("fused_flux")) {
+        std::vector<MetadataFlag> flags_flux = {Metadata::Real, Metadata::Cell, Metadata::Derived, Metadata::OneCopy};
+        Metadata m = Metadata(flags_flux, s_flux);
+        pkg->AddField("Flux.Pr", m);
+        pkg->AddField("Flux.Pl", m);
+        pkg->AddField("Flux.Ur", m);
+        pkg->AddField("Flux.Ul", m);
+        pkg->AddField("Flux.Fr", m);
+        pkg->AddField("Flux.Fl", m);
+    }
 
     std::vector<int> s_vector({NVEC});
     std::vector<MetadataFlag> flags_speed = {Metadata::Real, Metadata::Cell, Metadata::Derived, Metadata::OneCopy};
-    m = Metadata(flags_speed, s_vector);
+    Metadata m = Metadata(flags_speed, s_vector);
     pkg->AddField("Flux.cmax", m);
     pkg->AddField("Flux.cmin", m);
 
@@ -275,12 +278,14 @@ void Flux::AddGeoSource(MeshData<Real> *md, MeshData<Real> *mdudt)
             // Call Flux::calc_tensor which will in turn call the right calc_tensor based on the number of primitives
             Real Tmu[GR_DIM]    = {0};
             Real new_du[GR_DIM] = {0};
+            Real gdet_conn[GR_DIM][GR_DIM][GR_DIM];
+            G.gdet_conn(j, i, gdet_conn);
             for (int mu = 0; mu < GR_DIM; ++mu) {
                 Flux::calc_tensor(P(b), m_p, D, emhd_params, gam, k, j, i, mu, Tmu);
                 for (int nu = 0; nu < GR_DIM; ++nu) {
                     // Contract mhd stress tensor with connection, and multiply by metric determinant
                     for (int lam = 0; lam < GR_DIM; ++lam) {
-                        new_du[lam] += Tmu[nu] * G.gdet_conn(j, i, nu, lam, mu);
+                        new_du[lam] += Tmu[nu] * gdet_conn[nu][lam][mu];
                     }
                 }
             }
@@ -293,8 +298,9 @@ void Flux::AddGeoSource(MeshData<Real> *md, MeshData<Real> *mdudt)
 
 TaskStatus Flux::CheckCtop(MeshData<Real> *md)
 {
-    Reductions::DomainReduction<Reductions::Var::nan_ctop, int>(md, UserHistoryOperation::sum, 0);
-    Reductions::DomainReduction<Reductions::Var::zero_ctop, int>(md, UserHistoryOperation::sum, 1);
+    // One sweep for both checks, reduced together on vector<int> channel 3
+    Reductions::DomainReductions<int>(md, {Reductions::Var::nan_ctop, Reductions::Var::zero_ctop},
+                                      {UserHistoryOperation::sum, UserHistoryOperation::sum}, 3);
     return TaskStatus::complete;
 }
 
@@ -310,8 +316,9 @@ TaskStatus Flux::PostStepDiagnostics(const SimTime& tm, MeshData<Real> *md)
     // This functions as a "last resort" check to stop a
     // simulation on obviously bad data
     if (extra_checks >= 1) {
-        int nnan = Reductions::Check<int>(md, 0);
-        int nzero = Reductions::Check<int>(md, 1);
+        const std::vector<int> nbad = Reductions::Check<std::vector<int>>(md, 3);
+        const int nnan = nbad[0];
+        const int nzero = nbad[1];
 
         if (MPIRank0() && (nzero > 0 || nnan > 0)) {
             // TODO string formatting in C++ that doesn't suck
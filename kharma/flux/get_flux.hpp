@@ -40,6 +40,166 @@
 
 namespace Flux {
 
+/**
+ * @brief Fused version of GetFlux below: reconstruct, compute the left and right conserved states,
+ * fluxes and signal speeds, and apply the Riemann solver, all in a single outer loop.
+ *
+ * Each team keeps its pencil of face states in scratch, and writes only the final flux and
+ * "Flux.cmax"/"Flux.cmin" (plus "Flux.vl"/"Flux.vr" for B_CT) back to global memory.
+ * This avoids the round trips through "Flux.Pl", "Flux.Ul", etc., which are not even
+ * allocated when this mode is enabled.  Enable with <driver> fused_flux = true.
+ */
+template <KReconstruction::Type Recon, int dir>
+inline TaskStatus GetFluxFused(MeshData<Real> *md)
+{
+    // Pointers
+    auto pmesh = md->GetMeshPointer();
+    auto pmb0  = md->GetBlockData(0)->GetBlockPointer();
+    auto& packages = pmb0->packages;
+
+    Flag("GetFluxFused_"+std::to_string(dir));
+
+    // Options
+    const auto& pars       = packages.Get("Driver")->AllParams();
+    const auto& mhd_pars   = packages.Get("GRMHD")->AllParams();
+    const auto& globals    = packages.Get("Globals")->AllParams();
+    const bool use_hlle    = pars.Get<bool>("use_hlle");
+    const bool use_b_ct    = packages.AllPackages().count("B_CT");
+
+    // Post-reconstruction floors, see GetFlux
+    const bool reconstruction_floors = packages.AllPackages().count("Floors") &&
+                                       (Recon == KReconstruction::Type::weno5);
+    Floors::Prescription floors_temp;
+    if (reconstruction_floors) {
+        const auto& floor_pars = packages.Get("Floors")->AllParams();
+        floors_temp = Floors::Prescription(floor_pars);
+    }
+    const Floors::Prescription& floors = floors_temp;
+
+    const Real gam = mhd_pars.Get<Real>("gamma");
+
+    const EMHD::EMHD_parameters& emhd_params = EMHD::GetEMHDParameters(packages);
+
+    const Loci loc = loc_of(dir);
+    const TopologicalElement face = (dir == 1) ? F1 : ((dir == 2) ? F2 : F3);
+
+    // Pack variables.  Face B and velocities are only non-empty under B_CT
+    PackIndexMap prims_map, cons_map;
+    const auto& cmax  = md->PackVariables(std::vector<std::string>{"Flux.cmax"});
+    const auto& cmin  = md->PackVariables(std::vector<std::string>{"Flux.cmin"});
+    const auto& P_all = md->PackVariables(std::vector<MetadataFlag>{Metadata::GetUserFlag("Primitive"), Metadata::Cell}, prims_map);
+    const auto& U_all = md->PackVariablesAndFluxes(std::vector<MetadataFlag>{Metadata::Conserved, Metadata::Cell}, cons_map);
+    const VarMap m_u(cons_map, true), m_p(prims_map, false);
+    const auto& Bf     = md->PackVariables(std::vector<std::string>{"cons.fB"});
+    const auto& vl_all = md->PackVariables(std::vector<std::string>{"Flux.vl"});
+    const auto& vr_all = md->PackVariables(std::vector<std::string>{"Flux.vr"});
+
+    // Get the domain size
+    const IndexRange3 b = KDomain::GetRange(md, IndexDomain::interior, -1, 2);
+    // Get other sizes we need
+    const int n1 = pmb0->cellbounds.ncellsi(IndexDomain::entire);
+    const IndexRange block = IndexRange{0, cmax.GetDim(5) - 1};
+    const int nvar = U_all.GetDim(4);
+
+    if (globals.Get<int>("verbose") > 2) {
+        std::cout << "Calculating fused fluxes for " << cmax.GetDim(5) << " blocks, "
+                << nvar << " variables (" << P_all.GetDim(4) << " primitives)" << std::endl;
+        m_u.print(); m_p.print();
+        emhd_params.print();
+    }
+
+    // Allocate scratch space
+    const int scratch_level = 1; // 0 is actual scratch (tiny); 1 is HBM
+    const size_t var_size_in_bytes = parthenon::ScratchPad2D<Real>::shmem_size(nvar, n1);
+    // Prims, conserved, and fluxes for left and right faces, plus the temporaries
+    // used inside reconstruction (as in GetFlux)
+    const size_t total_scratch_bytes = (6 + 1*(Recon != KReconstruction::Type::weno5) +
+                                            4*(Recon == KReconstruction::Type::linear_vl)) * var_size_in_bytes;
+
+    parthenon::par_for_outer(DEFAULT_OUTER_LOOP_PATTERN, "calc_flux_fused", pmb0->exec_space,
+        total_scratch_bytes, scratch_level, block.s, block.e, b.ks, b.ke, b.js, b.je,
+        KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int& bl, const int& k, const int& j) {
+            const auto& G = U_all.GetCoords(bl);
+            // Allocate everything before reconstruction, which allocates its own temporaries after these
+            ScratchPad2D<Real> Pl_s(member.team_scratch(scratch_level), nvar, n1);
+            ScratchPad2D<Real> Pr_s(member.team_scratch(scratch_level), nvar, n1);
+            ScratchPad2D<Real> Ul_s(member.team_scratch(scratch_level), nvar, n1);
+            ScratchPad2D<Real> Ur_s(member.team_scratch(scratch_level), nvar, n1);
+            ScratchPad2D<Real> Fl_s(member.team_scratch(scratch_level), nvar, n1);
+            ScratchPad2D<Real> Fr_s(member.team_scratch(scratch_level), nvar, n1);
+
+            KReconstruction::reconstruct<Recon, dir>(member, P_all(bl), k, j, b.is, b.ie, Pl_s, Pr_s);
+
+            // Sync all threads in the team so that scratch memory is consistent
+            member.team_barrier();
+
+            // Everything from here on is local to a single face, so needs no further barriers
+            parthenon::par_for_inner(member, b.is, b.ie,
+                [&](const int& i) {
+                    auto Pl = Kokkos::subview(Pl_s, Kokkos::ALL(), i);
+                    auto Pr = Kokkos::subview(Pr_s, Kokkos::ALL(), i);
+                    auto Ul = Kokkos::subview(Ul_s, Kokkos::ALL(), i);
+                    auto Ur = Kokkos::subview(Ur_s, Kokkos::ALL(), i);
+                    auto Fl = Kokkos::subview(Fl_s, Kokkos::ALL(), i);
+                    auto Fr = Kokkos::subview(Fr_s, Kokkos::ALL(), i);
+
+                    if (reconstruction_floors) {
+                        Floors::apply_geo_floors(G, Pl, m_p, gam, j, i, floors, loc);
+                        Floors::apply_geo_floors(G, Pr, m_p, gam, j, i, floors, loc);
+                    }
+
+                    // If we have B field on faces, we must replace reconstructed version with that
+                    if (use_b_ct) {
+                        const Real bf = Bf(bl, face, 0, k, j, i) / G.gdet(loc, j, i);
+                        Pl(m_p.B1+dir-1) = bf;
+                        Pr(m_p.B1+dir-1) = bf;
+                        // Save the face velocities for upwinding/CT later
+                        VLOOP {
+                            vl_all(bl, face, v, k, j, i) = Pl(m_p.U1+v);
+                            vr_all(bl, face, v, k, j, i) = Pr(m_p.U1+v);
+                        }
+                    }
+
+                    // Declare temporary vectors
+                    FourVectors Dtmp;
+
+                    // Left
+                    GRMHD::calc_4vecs(G, Pl, m_p, j, i, loc, Dtmp);
+                    Flux::prim_to_flux(G, Pl, m_p, Dtmp, emhd_params, gam, j, i, 0, Ul, m_u, loc);
+                    Flux::prim_to_flux(G, Pl, m_p, Dtmp, emhd_params, gam, j, i, dir, Fl, m_u, loc);
+                    Real cmaxL, cminL;
+                    Flux::vchar(G, Pl, m_p, Dtmp, gam, emhd_params, k, j, i, loc, dir, cmaxL, cminL);
+
+                    // Right
+                    GRMHD::calc_4vecs(G, Pr, m_p, j, i, loc, Dtmp);
+                    Flux::prim_to_flux(G, Pr, m_p, Dtmp, emhd_params, gam, j, i, 0, Ur, m_u, loc);
+                    Flux::prim_to_flux(G, Pr, m_p, Dtmp, emhd_params, gam, j, i, dir, Fr, m_u, loc);
+                    Real cmaxR, cminR;
+                    Flux::vchar(G, Pr, m_p, Dtmp, gam, emhd_params, k, j, i, loc, dir, cmaxR, cminR);
+
+                    // Same operations as the split version, so results are bitwise identical
+                    const Real cmax_f = m::abs(m::max(m::max(0., cmaxL),  cmaxR));
+                    const Real cmin_f = m::abs(m::max(m::max(0., -cminL), -cminR));
+                    cmax(bl, dir-1, k, j, i) = cmax_f;
+                    cmin(bl, dir-1, k, j, i) = cmin_f;
+
+                    // Apply what we've calculated
+                    if (use_hlle) {
+                        for (int p=0; p < nvar; ++p)
+                            U_all(bl).flux(dir, p, k, j, i) = hlle(Fl(p), Fr(p), cmax_f, cmin_f, Ul(p), Ur(p));
+                    } else {
+                        for (int p=0; p < nvar; ++p)
+                            U_all(bl).flux(dir, p, k, j, i) = llf(Fl(p), Fr(p), cmax_f, cmin_f, Ul(p), Ur(p));
+                    }
+                }
+            );
+        }
+    );
+
+    EndFlag();
+    return TaskStatus::complete;
+}
+
 /**
  * @brief Reconstruct the values of primitive variables at left and right of each zone face,
  * find the corresponding conserved variables and their fluxes through the face
@@ -69,10 +229,13 @@ inline TaskStatus GetFlux(MeshData<Real> *md)
     if (ndim < 3 && dir == X3DIR) return TaskStatus::complete;
     if (ndim < 2 && dir == X2DIR) return TaskStatus::complete;
 
+    // Optionally run everything in one kernel, see GetFluxFused above
+    const auto& pars       = packages.Get("Driver")->AllParams();
+    if (pars.Get<bool>("fused_flux")) return GetFluxFused<Recon, dir>(md);
+
     Flag("GetFlux_"+std::to_string(dir));
 
     // Options
-    const auto& pars       = packages.Get("Driver")->AllParams();
     const auto& mhd_pars   = packages.Get("GRMHD")->AllParams();
     const auto& globals    = packages.Get("Globals")->AllParams();
     const bool use_hlle    = pars.Get<bool>("use_hlle");
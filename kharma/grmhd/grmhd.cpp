@@ -202,12 +202,7 @@ Real EstimateTimestep(MeshBlockData<Real> *rc)
     // like this is inadvisable: you have to EndFlag() at every different return
     Flag("EstimateTimestep");
     auto pmb = rc->GetBlockPointer();
-    IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
-    IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
-    IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
     const auto& G = pmb->coords;
-    auto& cmax = rc->Get("Flux.cmax").data;
-    auto& cmin = rc->Get("Flux.cmin").data;
 
     // TODO: move timestep limiters into KHARMADriver::SetGlobalTimestep
     // TODO: option to keep location (in embedding coords) of zone which sets step.
@@ -246,23 +241,7 @@ Real EstimateTimestep(MeshBlockData<Real> *rc)
         return globals.Get<double>("dt_light");
     }
 
-    ParArray1D<Real> min_loc("min_loc", 3);
-
-    // TODO version preserving location, with switch to keep this fast one
-    // std::tuple doesn't work device-side, Kokkos::pair is 2D.  pair of pairs?
-    Real min_ndt = 0.;
-    pmb->par_reduce("ndt_min", kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
-        KOKKOS_LAMBDA (const int k, const int j, const int i,
-                      Real &local_result) {
-            double ndt_zone = 1 / (1 / (G.Dxc<1>(i) /  m::max(cmax(0, k, j, i), cmin(0, k, j, i))) +
-                                   1 / (G.Dxc<2>(j) /  m::max(cmax(1, k, j, i), cmin(1, k, j, i))) +
-                                   1 / (G.Dxc<3>(k) /  m::max(cmax(2, k, j, i), cmin(2, k, j, i))));
-
-            if (!m::isnan(ndt_zone) && (ndt_zone < local_result)) {
-                local_result = ndt_zone;
-            }
-        }
-    , Kokkos::Min<Real>(min_ndt));
+    const Real min_ndt = MinCrossingTime(rc);
     // TODO(BSP) this would need work for non-rectangular grids.
     const double nctop = m::min(G.Dxc<1>(0), m::min(G.Dxc<2>(0), G.Dxc<3>(0))) / min_ndt;
 
@@ -288,6 +267,34 @@ Real EstimateTimestep(MeshBlockData<Real> *rc)
     return ndt;
 }
 
+Real MinCrossingTime(MeshBlockData<Real> *rc)
+{
+    auto pmb = rc->GetBlockPointer();
+    IndexRange ib = pmb->cellbounds.GetBoundsI(IndexDomain::interior);
+    IndexRange jb = pmb->cellbounds.GetBoundsJ(IndexDomain::interior);
+    IndexRange kb = pmb->cellbounds.GetBoundsK(IndexDomain::interior);
+    const auto& G = pmb->coords;
+    auto& cmax = rc->Get("Flux.cmax").data;
+    auto& cmin = rc->Get("Flux.cmin").data;
+
+    // TODO version preserving location, with switch to keep this fast one
+    // std::tuple doesn't work device-side, Kokkos::pair is 2D.  pair of pairs?
+    Real min_ndt = 0.;
+    pmb->par_reduce("ndt_min", kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+        KOKKOS_LAMBDA (const int k, const int j, const int i,
+                      Real &local_result) {
+            double ndt_zone = 1 / (1 / (G.Dxc<1>(i) /  m::max(cmax(0, k, j, i), cmin(0, k, j, i))) +
+                                   1 / (G.Dxc<2>(j) /  m::max(cmax(1, k, j, i), cmin(1, k, j, i))) +
+                                   1 / (G.Dxc<3>(k) /  m::max(cmax(2, k, j, i), cmin(2, k, j, i))));
+
+            if (!m::isnan(ndt_zone) && (ndt_zone < local_result)) {
+                local_result = ndt_zone;
+            }
+        }
+    , Kokkos::Min<Real>(min_ndt));
+    return min_ndt;
+}
+
 Real EstimateRadiativeTimestep(MeshBlockData<Real> *rc)
 {
     Flag("EstimateRadiativeTimestep");
@@ -397,13 +404,14 @@ TaskStatus PostStepDiagnostics(const SimTime& tm, MeshData<Real> *md)
     if (extra_checks >= 2) {
         // Not sure when I'd do the check to hide latency, it's a step-end sort of deal
         // Just as well it's behind extra_checks 2
-        // This may happen while ch0-1 are in flight from floors, but ch2-4 are now reusable
-        Reductions::DomainReduction<Reductions::Var::neg_rho, int>(md, UserHistoryOperation::sum, 2);
-        Reductions::DomainReduction<Reductions::Var::neg_u, int>(md, UserHistoryOperation::sum, 3);
-        Reductions::DomainReduction<Reductions::Var::neg_rhout, int>(md, UserHistoryOperation::sum, 4);
-        int nless_rho = Reductions::Check<int>(md, 2);
-        int nless_u = Reductions::Check<int>(md, 3);
-        int nless_rhout = Reductions::Check<int>(md, 4);
+        // All three counts are taken in one sweep, and reduced together on vector<int> channel 4
+        // (0-2 are used by the flag reductions, 3 by ctop checks)
+        Reductions::DomainReductions<int>(md, {Reductions::Var::neg_rho, Reductions::Var::neg_u, Reductions::Var::neg_rhout},
+                                          {UserHistoryOperation::sum, UserHistoryOperation::sum, UserHistoryOperation::sum}, 4);
+        const std::vector<int> nless = Reductions::Check<std::vector<int>>(md, 4);
+        const int nless_rho = nless[0];
+        const int nless_u = nless[1];
+        const int nless_rhout = nless[2];
 
         if (MPIRank0()) {
             if (nless_rhout > 0) {
@@ -67,6 +67,13 @@ inline Real MeshEstimateTimestep(MeshData<Real> *md)
     return ndt;
 }
 
+/**
+ * Minimum signal crossing time of any zone in the block, from the last step's ctop,
+ * without the CFL factor or any limits.  Used by EstimateTimestep, and to sort blocks into
+ * timestep bins for multi-rate stepping
+ */
+Real MinCrossingTime(MeshBlockData<Real> *rc);
+
 // Internal version for the light phase speed crossing time of smallest zone
 Real EstimateRadiativeTimestep(MeshBlockData<Real> *rc);
 
@@ -33,6 +33,7 @@
  */
 
 #include "implicit.hpp"
+#include "implicit_ad.hpp"
 
 #include "grmhd.hpp"
 #include "grmhd_functions.hpp"
@@ -48,17 +49,13 @@ std::shared_ptr<KHARMAPackage> Implicit::Initialize(ParameterInput *pin, std::sh
 { throw std::runtime_error("KHARMA was compiled without implicit stepping support!"); }
 // We still need a stub for Step() in order to compile, but it will never be called
 TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_sub_step_init, MeshData<Real> *md_flux_src,
-                MeshData<Real> *md_linesearch, MeshData<Real> *md_solver, const Real& dt) {}
+                MeshData<Real> *md_solver, const Real& dt) {}
 
 #else
 
 // Implicit nonlinear solve requires several linear solves per-zone
-// Use Kokkos-kernels QR decomposition & triangular solve, they're fast.
-#include <KokkosBatched_LU_Decl.hpp>
-#include <KokkosBatched_QR_Decl.hpp>
-#include <KokkosBatched_ApplyQ_Decl.hpp>
-#include <KokkosBatched_Trsv_Decl.hpp>
-#include <KokkosBatched_ApplyPivot_Decl.hpp>
+// These are small enough to do in registers, see linear_solve.hpp
+#include "linear_solve.hpp"
 
 std::vector<std::string> Implicit::GetOrderedNames(MeshBlockData<Real> *rc, const MetadataFlag& flag, bool only_implicit)
 {
@@ -90,6 +87,43 @@ std::shared_ptr<KHARMAPackage> Implicit::Initialize(ParameterInput *pin, std::sh
     pin->SetString("parthenon/time", "integrator", "vl2");
 
     // Implicit solver parameters
+    // The Jacobian is computed either by forward finite differences with step jacobian_delta ("numerical"),
+    // or exactly in a single residual evaluation by forward-mode automatic differentiation ("analytic")
+    std::string jacobian = pin->GetOrAddString("implicit", "jacobian", "numerical");
+    if (jacobian != "numerical" && jacobian != "analytic") {
+        throw std::invalid_argument("Implicit Jacobian must be one of numerical, analytic!");
+    }
+    // Size of the per-zone system, i.e. the number of implicit primitives.
+    // Count only the primitives: conserved forms of implicit variables are flagged "Implicit" too
+    using FC = Metadata::FlagCollection;
+    const int nfvar = KHARMA::PackDimension(packages.get(), FC({Metadata::GetUserFlag("Implicit"),
+                                                                Metadata::GetUserFlag("Primitive")}));
+    const bool analytic_jacobian = (jacobian == "analytic");
+    if (analytic_jacobian) {
+        if (nfvar > IMPLICIT_AD_NVAR) {
+            throw std::invalid_argument("Analytic implicit Jacobian supports at most "+std::to_string(IMPLICIT_AD_NVAR)+
+                                        " implicit variables, got "+std::to_string(nfvar)+". Use jacobian=numerical.");
+        }
+    }
+    params.Add("analytic_jacobian", analytic_jacobian);
+    // Quasi-Newton options.  Rather than recomputing the Jacobian every iteration, "reuse" keeps the Jacobian
+    // from the first iteration of each sub-step, and "broyden" applies rank-1 (Broyden) updates to it.
+    // Either way, a zone's Jacobian is recomputed after any iteration which fails to reduce its residual norm
+    // by at least a factor jacobian_refresh_ratio.
+    std::string jacobian_update_s = pin->GetOrAddString("implicit", "jacobian_update", "newton");
+    JacobianUpdate jacobian_update;
+    if (jacobian_update_s == "newton") {
+        jacobian_update = JacobianUpdate::newton;
+    } else if (jacobian_update_s == "reuse") {
+        jacobian_update = JacobianUpdate::reuse;
+    } else if (jacobian_update_s == "broyden") {
+        jacobian_update = JacobianUpdate::broyden;
+    } else {
+        throw std::invalid_argument("Implicit Jacobian update must be one of newton, reuse, broyden!");
+    }
+    params.Add("jacobian_update", jacobian_update);
+    Real jacobian_refresh_ratio = pin->GetOrAddReal("implicit", "jacobian_refresh_ratio", 0.5);
+    params.Add("jacobian_refresh_ratio", jacobian_refresh_ratio);
     Real jacobian_delta = pin->GetOrAddReal("implicit", "jacobian_delta", 4.e-8);
     params.Add("jacobian_delta", jacobian_delta);
     Real rootfind_tol = pin->GetOrAddReal("implicit", "rootfind_tol", 1.e-12);
@@ -98,10 +132,13 @@ std::shared_ptr<KHARMAPackage> Implicit::Initialize(ParameterInput *pin, std::sh
     params.Add("min_nonlinear_iter", min_nonlinear_iter);
     int max_nonlinear_iter = pin->GetOrAddInteger("implicit", "max_nonlinear_iter", 3);
     params.Add("max_nonlinear_iter", max_nonlinear_iter);
-    // The QR decomposition bundled with KHARMA has column pivoting for stability.
-    // The alternative LU decomposition does not, and should mostly be used for debugging.
+    // Per-zone linear solves use QR decomposition with column pivoting by default.
+    // The alternative LU decomposition uses partial pivoting, and is cheaper but less robust.
     bool use_qr = pin->GetOrAddBoolean("implicit", "use_qr", true);
     params.Add("use_qr", use_qr);
+    if (nfvar > IMPLICIT_MAX_NVAR) {
+        throw std::invalid_argument("Implicit solver supports at most "+std::to_string(IMPLICIT_MAX_NVAR)+" implicit variables!");
+    }
 
     bool linesearch = pin->GetOrAddBoolean("implicit", "linesearch", true);
     params.Add("linesearch", linesearch);
@@ -120,6 +157,13 @@ std::shared_ptr<KHARMAPackage> Implicit::Initialize(ParameterInput *pin, std::sh
     m_real = Metadata({Metadata::Real, Metadata::Cell, Metadata::Derived, Metadata::OneCopy, Metadata::FillGhost});
     pkg->AddField("solve_fail", m_real); // TODO: Replace with m_int once Integer is supported for CellVariable
 
+    // Quasi-Newton iterations keep each zone's Jacobian between iterations, and whether it must be recomputed
+    if (jacobian_update != JacobianUpdate::newton) {
+        std::vector<int> s_jacobian({nfvar*nfvar});
+        pkg->AddField("solve_jacobian", Metadata({Metadata::Real, Metadata::Cell, Metadata::Derived, Metadata::OneCopy}, s_jacobian));
+        pkg->AddField("solve_jacobian_refresh", Metadata({Metadata::Real, Metadata::Cell, Metadata::Derived, Metadata::OneCopy}));
+    }
+
     // Should the solve save the residual vector field? Useful for debugging purposes. Default is NO.
     bool save_residual = pin->GetOrAddBoolean("implicit", "save_residual", false);
     params.Add("save_residual", save_residual);
@@ -139,7 +183,7 @@ std::shared_ptr<KHARMAPackage> Implicit::Initialize(ParameterInput *pin, std::sh
 }
 
 TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_sub_step_init, MeshData<Real> *md_flux_src,
-                MeshData<Real> *md_linesearch, MeshData<Real> *md_solver, const Real& dt)
+                MeshData<Real> *md_solver, const Real& dt)
 {
     Flag("Implicit::Step");
     // Pull out the block pointers for each sub-step, as we need the *mutable parameters*
@@ -147,7 +191,6 @@ TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_
     auto pmb_full_step_init = md_full_step_init->GetBlockData(0)->GetBlockPointer();
     auto pmb_sub_step_init  = md_sub_step_init->GetBlockData(0)->GetBlockPointer();
     auto pmb_solver         = md_solver->GetBlockData(0)->GetBlockPointer();
-    auto pmb_linesearch     = md_linesearch->GetBlockData(0)->GetBlockPointer();
 
     // Parameters
     const auto& implicit_par = pmb_full_step_init->packages.Get("Implicit")->AllParams();
@@ -156,6 +199,11 @@ TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_
     const Real delta         = implicit_par.Get<Real>("jacobian_delta");
     const Real rootfind_tol  = implicit_par.Get<Real>("rootfind_tol");
     const bool use_qr        = implicit_par.Get<bool>("use_qr");
+    const bool analytic_jac  = implicit_par.Get<bool>("analytic_jacobian");
+    const JacobianUpdate jac_update = implicit_par.Get<JacobianUpdate>("jacobian_update");
+    const Real refresh_ratio = implicit_par.Get<Real>("jacobian_refresh_ratio");
+    const bool quasi_newton  = jac_update != JacobianUpdate::newton;
+    const bool broyden       = jac_update == JacobianUpdate::broyden;
     const auto& globals      = pmb_full_step_init->packages.Get("Globals")->AllParams();
     const int verbose        = globals.Get<int>("verbose");
     const int flag_verbose   = globals.Get<int>("flag_verbose");
@@ -170,19 +218,16 @@ TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_
 
     // Misc other constants for inside the kernel
     const bool am_rank0 = MPIRank0();
-    const Real tiny(SMALL), alpha(1.0);
+    const Real tiny(SMALL);
 
     // We need two sets of emhd_params because we need the relaxation scale
     // at the same state in the implicit source terms
-    // Need an object of `EMHD_parameters` for the `linesearch` state
-    EMHD_parameters emhd_params_sub_step_init, emhd_params_solver, emhd_params_linesearch;
+    EMHD_parameters emhd_params_sub_step_init, emhd_params_solver;
     if (pmb_sub_step_init->packages.AllPackages().count("EMHD")) {
         const auto& pars_sub_step_init  = pmb_sub_step_init->packages.Get("EMHD")->AllParams();
         const auto& pars_solver         = pmb_solver->packages.Get("EMHD")->AllParams();
-        const auto& pars_linesearch     = pmb_linesearch->packages.Get("EMHD")->AllParams();
         emhd_params_sub_step_init       = pars_sub_step_init.Get<EMHD_parameters>("emhd_params");
         emhd_params_solver              = pars_solver.Get<EMHD_parameters>("emhd_params");
-        emhd_params_linesearch          = pars_linesearch.Get<EMHD_parameters>("emhd_params");
     }
 
     // I don't normally do this, but we *really* care about variable ordering here.
@@ -202,12 +247,11 @@ TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_
     const VarMap m_u(cons_map, true), m_p(prims_map, false);
     // Current sub-step starting state.
     auto& P_sub_step_init_all = md_sub_step_init->PackVariables(ordered_prims);
-    auto& U_sub_step_init_all = md_sub_step_init->PackVariables(ordered_cons);
     // Flux divergence plus explicit source terms. This is what we'd be adding.
     auto& flux_src_all = md_flux_src->PackVariables(ordered_cons);
     // Guess at initial state. We update only the implicit primitive vars
+    // The linesearch state is kept only in scratch, see below
     auto& P_solver_all     = md_solver->PackVariables(ordered_prims);
-    auto& P_linesearch_all = md_linesearch->PackVariables(ordered_prims);
 
     // Sizes and scratchpads
     const int nblock = U_full_step_init_all.GetDim(5);
@@ -223,6 +267,9 @@ TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_
     // Pull fields associated with the solver's performance
     auto& solve_norm_all = md_solver->PackVariables(std::vector<std::string>{"solve_norm"});
     auto& solve_fail_all = md_solver->PackVariables(std::vector<std::string>{"solve_fail"});
+    // Saved Jacobians for quasi-Newton iterations (empty otherwise)
+    auto& solve_jacobian_all = md_solver->PackVariables(std::vector<std::string>{"solve_jacobian"});
+    auto& solve_refresh_all  = md_solver->PackVariables(std::vector<std::string>{"solve_jacobian_refresh"});
 
     auto bounds  = pmb_sub_step_init->cellbounds;
     const int n1 = bounds.ncellsi(IndexDomain::entire);
@@ -248,30 +295,28 @@ TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_
     // Allocate scratch space
     // It is impossible to declare runtime-sized arrays in CUDA
     // of e.g. length var[nvar] (recall nvar can change at runtime in KHARMA)
-    // Instead we copy to scratch!
-    // This allows flexibility in structuring the kernel, and the results can be sliced
-    // to avoid a bunch of indices in all the device-side operations
+    // Instead we use scratch for anything we write, sliced to avoid a bunch of indices
+    // in all the device-side operations.
+    // Read-only inputs are not copied, but read in place through PackZone objects.
     // See grmhd_functions.hpp for the other approach with overloads
     const int scratch_level = 1; // 0 is actual scratch (tiny); 1 is HBM
     const size_t var_size_in_bytes    = parthenon::ScratchPad2D<Real>::shmem_size(n1, nvar);
     const size_t fvar_size_in_bytes   = parthenon::ScratchPad2D<Real>::shmem_size(n1, nfvar);
     const size_t tensor_size_in_bytes = parthenon::ScratchPad3D<Real>::shmem_size(nfvar, n1, nfvar);
     const size_t scalar_size_in_bytes = parthenon::ScratchPad1D<Real>::shmem_size(n1);
-    const size_t int_size_in_bytes    = parthenon::ScratchPad1D<int>::shmem_size(n1);
     // Allocate enough to cache:
     // jacobian (2D)
-    // residual, deltaP, trans, work (implicit only)
-    // P_full_step_init/U_full_step_init, P_sub_step_init/U_sub_step_init, flux_src, 
-    // P_solver, P_linesearch, dU_implicit, three temps (all vars)
+    // residual, deltaP, one temp (implicit only)
+    // P_solver, dU_implicit, two temps (all vars)
     // solve_norm, solve_fail
-
-    const size_t total_scratch_bytes = tensor_size_in_bytes + (6) * fvar_size_in_bytes + (11) * var_size_in_bytes + \
+    const size_t total_scratch_bytes = tensor_size_in_bytes + (3) * fvar_size_in_bytes + (4) * var_size_in_bytes + \
                                     (2) * scalar_size_in_bytes;
-                                    //  + int_size_in_bytes;
 
     // Iterate.  This loop is outside the kokkos kernel in order to print max_norm
     // There are generally a low and similar number of iterations between
     // different zones, so probably acceptable speed loss.
+    // Converged zones are not recomputed (see zone_active below), so extra iterations cost
+    // only as much as the zones still being solved.
     for (int iter=1; iter <= iter_max; ++iter) {
         // Flags per iter, since debugging here will be rampant
         Flag("ImplicitIteration_"+std::to_string(iter));
@@ -279,47 +324,47 @@ TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_
         parthenon::par_for_outer(DEFAULT_OUTER_LOOP_PATTERN, "implicit_solve", pmb_sub_step_init->exec_space,
             total_scratch_bytes, scratch_level, block.s, block.e, kb.s, kb.e, jb.s, jb.e,
             KOKKOS_LAMBDA(parthenon::team_mbr_t member, const int& b, const int& k, const int& j) {
+                // Zones drop out of the solve once they fail, or once they have converged to rootfind_tol
+                // after at least iter_min iterations.  Their state is left as the previous iteration wrote it.
+                auto zone_active = [&](const int& i) {
+                    return iter == 1 || ((SolverStatus) solve_fail_all(b, 0, k, j, i) != SolverStatus::fail &&
+                                         (iter <= iter_min || solve_norm_all(b, 0, k, j, i) >= rootfind_tol));
+                };
+                // If no zone in this pencil is left, skip it entirely, including the copies to/from scratch
+                int n_active = 0;
+                Kokkos::parallel_reduce(Kokkos::TeamThreadRange(member, ib.s, ib.e + 1),
+                    [&](const int& i, int& local_active) {
+                        local_active += zone_active(i);
+                    }
+                , n_active);
+                if (n_active == 0) return;
+
                 const auto& G = U_full_step_init_all.GetCoords(b);
                 // Scratchpads for implicit vars
                 ScratchPad3D<Real> jacobian_s(member.team_scratch(scratch_level), n1, nfvar, nfvar);
                 ScratchPad2D<Real> residual_s(member.team_scratch(scratch_level), n1, nfvar);
                 ScratchPad2D<Real> delta_prim_s(member.team_scratch(scratch_level), n1, nfvar);
-                ScratchPad2D<int> pivot_s(member.team_scratch(scratch_level), n1, nfvar);
-                ScratchPad2D<Real> trans_s(member.team_scratch(scratch_level), n1, nfvar);
-                ScratchPad2D<Real> work_s(member.team_scratch(scratch_level), n1, 2*nfvar);
+                ScratchPad2D<Real> tmp2_s(member.team_scratch(scratch_level), n1, nfvar);
                 // Scratchpads for all vars
                 ScratchPad2D<Real> dU_implicit_s(member.team_scratch(scratch_level), n1, nvar);
                 ScratchPad2D<Real> tmp1_s(member.team_scratch(scratch_level), n1, nvar);
-                ScratchPad2D<Real> tmp2_s(member.team_scratch(scratch_level), n1, nfvar);
                 ScratchPad2D<Real> tmp3_s(member.team_scratch(scratch_level), n1, nvar);
-                ScratchPad2D<Real> P_full_step_init_s(member.team_scratch(scratch_level), n1, nvar);
-                ScratchPad2D<Real> U_full_step_init_s(member.team_scratch(scratch_level), n1, nvar);
-                ScratchPad2D<Real> P_sub_step_init_s(member.team_scratch(scratch_level), n1, nvar);
-                ScratchPad2D<Real> U_sub_step_init_s(member.team_scratch(scratch_level), n1, nvar);
-                ScratchPad2D<Real> flux_src_s(member.team_scratch(scratch_level), n1, nvar);
                 ScratchPad2D<Real> P_solver_s(member.team_scratch(scratch_level), n1, nvar);
-                ScratchPad2D<Real> P_linesearch_s(member.team_scratch(scratch_level), n1, nvar);
                 // Scratchpads for solver performance diagnostics
                 ScratchPad1D<Real> solve_norm_s(member.team_scratch(scratch_level), n1);
                 ScratchPad1D<SolverStatus> solve_fail_s(member.team_scratch(scratch_level), n1);
 
-                // Copy some file contents to scratchpads, so we can slice them
+                // Copy the current guess to scratch, and initialize the rest
                 for(int ip=0; ip < nvar; ++ip) {
-                    parthenon::par_for_inner(member, 0, n1-1,
+                    parthenon::par_for_inner(member, ib.s, ib.e,
                         [&](const int& i) {
-                            P_full_step_init_s(i, ip) = P_full_step_init_all(b)(ip, k, j, i);
-                            U_full_step_init_s(i, ip) = U_full_step_init_all(b)(ip, k, j, i);
-                            P_sub_step_init_s(i, ip)  = P_sub_step_init_all(b)(ip, k, j, i);
-                            U_sub_step_init_s(i, ip)  = U_sub_step_init_all(b)(ip, k, j, i);
-                            flux_src_s(i, ip)         = flux_src_all(b)(ip, k, j, i);
                             P_solver_s(i, ip)         = P_solver_all(b)(ip, k, j, i);
-                            P_linesearch_s(i, ip)     = P_linesearch_all(b)(ip, k, j, i);
                             dU_implicit_s(i, ip)      = 0.;
                             tmp1_s(i, ip) = 0.;
                             tmp3_s(i, ip) = 0.;
 
                             // TODO these are run repeatedly a bunch of times
-                            solve_norm_s(i) = 0.;
+                            solve_norm_s(i) = (iter == 1) ? 0. : solve_norm_all(b, 0, k, j, i);
                             if (iter == 1) {
                                 // New beginnings
                                 solve_fail_s(i) = SolverStatus::converged;
@@ -333,16 +378,12 @@ TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_
                 }
                 // For implicit only
                 for(int ip=0; ip < nfvar; ++ip) {
-                    parthenon::par_for_inner(member, 0, n1-1,
+                    parthenon::par_for_inner(member, ib.s, ib.e,
                         [&](const int& i) {
                             for(int jp=0; jp < nfvar; ++jp)
                                 jacobian_s(i, ip, jp) = 0.;
                             residual_s(i, ip) = 0.;
                             delta_prim_s(i, ip) = 0.;
-                            pivot_s(i, ip) = 0;
-                            trans_s(i, ip) = 0.;
-                            work_s(i, ip) = 0.;
-                            work_s(i, ip+nfvar) = 0.;
                             tmp2_s(i, ip) = 0.;
                         }
                     );
@@ -351,33 +392,32 @@ TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_
 
                 parthenon::par_for_inner(member, ib.s, ib.e,
                     [&](const int& i) {
+                        // Read-only inputs, directly from the packs
+                        const PackZone P_full_step_init{P_full_step_init_all(b), k, j, i};
+                        const PackZone U_full_step_init{U_full_step_init_all(b), k, j, i};
+                        const PackZone P_sub_step_init{P_sub_step_init_all(b), k, j, i};
+                        const PackZone flux_src{flux_src_all(b), k, j, i};
                         // Lots of slicing.  This still ends up faster & cleaner than alternatives I tried
-                        auto P_full_step_init = Kokkos::subview(P_full_step_init_s, i, Kokkos::ALL());
-                        auto U_full_step_init = Kokkos::subview(U_full_step_init_s, i, Kokkos::ALL());
-                        auto P_sub_step_init  = Kokkos::subview(P_sub_step_init_s, i, Kokkos::ALL());
-                        auto U_sub_step_init  = Kokkos::subview(U_sub_step_init_s, i, Kokkos::ALL());
-                        auto flux_src         = Kokkos::subview(flux_src_s, i, Kokkos::ALL());
                         auto P_solver         = Kokkos::subview(P_solver_s, i, Kokkos::ALL());
-                        auto P_linesearch     = Kokkos::subview(P_linesearch_s, i, Kokkos::ALL());
                         // Solver variables
                         auto residual   = Kokkos::subview(residual_s, i, Kokkos::ALL());
                         auto jacobian   = Kokkos::subview(jacobian_s, i, Kokkos::ALL(), Kokkos::ALL());
                         auto delta_prim = Kokkos::subview(delta_prim_s, i, Kokkos::ALL());
-                        auto pivot      = Kokkos::subview(pivot_s, i, Kokkos::ALL());
-                        auto trans      = Kokkos::subview(trans_s, i, Kokkos::ALL());
-                        auto work       = Kokkos::subview(work_s, i, Kokkos::ALL());
                         // Temporaries
                         auto tmp1  = Kokkos::subview(tmp1_s, i, Kokkos::ALL());
                         auto tmp2  = Kokkos::subview(tmp2_s, i, Kokkos::ALL());
                         auto tmp3  = Kokkos::subview(tmp3_s, i, Kokkos::ALL());
+                        // The linesearch state is only needed after the Jacobian, so it shares the
+                        // scratchpad used there for perturbed primitives
+                        auto P_linesearch = tmp1;
                         // Implicit sources at starting state
                         auto dU_implicit = Kokkos::subview(dU_implicit_s, i, Kokkos::ALL());
                         // Solver performance diagnostics
                         auto solve_norm = Kokkos::subview(solve_norm_s, i);
                         auto solve_fail = Kokkos::subview(solve_fail_s, i);
 
-                        // Perform the solve only if it hadn't failed in any of the previous iterations.
-                        if (solve_fail() != SolverStatus::fail) {
+                        // Perform the solve only if it hadn't failed or converged in any of the previous iterations.
+                        if (zone_active(i)) {
                             // Now that we know that it isn't a bad zone, reset solve_fail for this iteration
                             solve_fail() = SolverStatus::converged;
 
@@ -398,81 +438,33 @@ TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_
 
                             // Jacobian calculation
                             // Requires calculating the residual anyway, so we grab it here
-                            calc_jacobian(G, P_solver, P_full_step_init, U_full_step_init, P_sub_step_init, 
-                                        flux_src, dU_implicit, tmp1, tmp2, tmp3, m_p, m_u, emhd_params_solver,
-                                        emhd_params_sub_step_init, nvar, nfvar, k, j, i, delta, gam, dt, jacobian, residual);
-                            // Solve against the negative residual
-                            FLOOP delta_prim(ip) = -residual(ip);
-#if 0
-                        }
-                    }
-                );
-                member.team_barrier();
-                parthenon::par_for_inner(member, ib.s, ib.e,
-                    [&](const int& i) {
-                        // Solver variables
-                        auto residual   = Kokkos::subview(residual_s, i, Kokkos::ALL());
-                        auto jacobian   = Kokkos::subview(jacobian_s, i, Kokkos::ALL(), Kokkos::ALL());
-                        auto delta_prim = Kokkos::subview(delta_prim_s, i, Kokkos::ALL());
-                        auto pivot      = Kokkos::subview(pivot_s, i, Kokkos::ALL());
-                        auto trans      = Kokkos::subview(trans_s, i, Kokkos::ALL());
-                        auto work       = Kokkos::subview(work_s, i, Kokkos::ALL());
-                        auto solve_fail = Kokkos::subview(solve_fail_s, i);
-
-                        if (solve_fail() != SolverStatus::fail) {
-#endif
-                            if (use_qr) {
-                                // Linear solve by QR decomposition
-                                KokkosBatched::SerialQR<KokkosBatched::Algo::QR::Unblocked>::invoke(jacobian, trans, pivot, work);
-                                KokkosBatched::SerialApplyQ<KokkosBatched::Side::Left, KokkosBatched::Trans::Transpose,
-                                                            KokkosBatched::Algo::ApplyQ::Unblocked>
-                                ::invoke(jacobian, trans, delta_prim, work);
+                            // Quasi-Newton iterations instead reuse the Jacobian saved by the last iteration, if it was good enough
+                            const bool fresh_jac = !quasi_newton || iter == 1 || solve_refresh_all(b, 0, k, j, i) > 0.;
+                            if (!fresh_jac) {
+                                FLOOP for (int jp = 0; jp < nfvar; ++jp)
+                                    jacobian(ip, jp) = solve_jacobian_all(b, ip*nfvar + jp, k, j, i);
+                                calc_residual(G, P_solver, P_full_step_init, U_full_step_init, P_sub_step_init, flux_src, dU_implicit, tmp3,
+                                            m_p, m_u, emhd_params_solver, emhd_params_sub_step_init, nfvar, k, j, i, gam, dt, residual);
+                            } else if (analytic_jac) {
+                                calc_jacobian_ad(G, P_solver, P_full_step_init, U_full_step_init, P_sub_step_init,
+                                            flux_src, dU_implicit, m_p, m_u, emhd_params_solver,
+                                            emhd_params_sub_step_init, nfvar, k, j, i, gam, dt, jacobian, residual);
                             } else {
-                                KokkosBatched::SerialLU<KokkosBatched::Algo::LU::Unblocked>::invoke(jacobian, tiny);
+                                calc_jacobian(G, P_solver, P_full_step_init, U_full_step_init, P_sub_step_init, 
+                                            flux_src, dU_implicit, tmp1, tmp2, tmp3, m_p, m_u, emhd_params_solver,
+                                            emhd_params_sub_step_init, nvar, nfvar, k, j, i, delta, gam, dt, jacobian, residual);
                             }
-                            KokkosBatched::SerialTrsv<KokkosBatched::Uplo::Upper, KokkosBatched::Trans::NoTranspose, 
-                                                    KokkosBatched::Diag::NonUnit, KokkosBatched::Algo::Trsv::Unblocked>
-                            ::invoke(alpha, jacobian, delta_prim);
-                            if (use_qr) {
-                                // Linear solve by QR decomposition
-                                KokkosBatched::SerialApplyPivot<KokkosBatched::Side::Left,KokkosBatched::Direct::Backward>
-                                    ::invoke(pivot, delta_prim);
+                            // Keep the starting residual, to judge progress & for the Broyden update
+                            Real norm_start = 0.;
+                            if (quasi_newton) {
+                                FLOOP norm_start += residual(ip) * residual(ip);
+                                norm_start = m::sqrt(norm_start);
+                                FLOOP tmp2(ip) = residual(ip);
                             }
-#if 0
-                        }
-                    }
-                );
-                member.team_barrier();
-
-                parthenon::par_for_inner(member, ib.s, ib.e,
-                    [&](const int& i) {
-                        // Lots of slicing.  This still ends up faster & cleaner than alternatives I tried
-                        auto P_full_step_init = Kokkos::subview(P_full_step_init_s, i, Kokkos::ALL());
-                        auto U_full_step_init = Kokkos::subview(U_full_step_init_s, i, Kokkos::ALL());
-                        auto P_sub_step_init  = Kokkos::subview(P_sub_step_init_s, i, Kokkos::ALL());
-                        auto U_sub_step_init  = Kokkos::subview(U_sub_step_init_s, i, Kokkos::ALL());
-                        auto flux_src         = Kokkos::subview(flux_src_s, i, Kokkos::ALL());
-                        auto P_solver         = Kokkos::subview(P_solver_s, i, Kokkos::ALL());
-                        auto P_linesearch     = Kokkos::subview(P_linesearch_s, i, Kokkos::ALL());
-                        // Solver variables
-                        auto residual   = Kokkos::subview(residual_s, i, Kokkos::ALL());
-                        auto jacobian   = Kokkos::subview(jacobian_s, i, Kokkos::ALL(), Kokkos::ALL());
-                        auto delta_prim = Kokkos::subview(delta_prim_s, i, Kokkos::ALL());
-                        auto pivot      = Kokkos::subview(pivot_s, i, Kokkos::ALL());
-                        auto trans      = Kokkos::subview(trans_s, i, Kokkos::ALL());
-                        auto work       = Kokkos::subview(work_s, i, Kokkos::ALL());
-                        // Temporaries
-                        auto tmp1  = Kokkos::subview(tmp1_s, i, Kokkos::ALL());
-                        auto tmp2  = Kokkos::subview(tmp2_s, i, Kokkos::ALL());
-                        auto tmp3  = Kokkos::subview(tmp3_s, i, Kokkos::ALL());
-                        // Implicit sources at starting state
-                        auto dU_implicit = Kokkos::subview(dU_implicit_s, i, Kokkos::ALL());
-                        // Solver performance diagnostics
-                        auto solve_norm = Kokkos::subview(solve_norm_s, i);
-                        auto solve_fail = Kokkos::subview(solve_fail_s, i);
-
-                        if (solve_fail() != SolverStatus::fail) {
-#endif
+                            // Solve against the negative residual
+                            FLOOP delta_prim(ip) = -residual(ip);
+                            // Solve in place, delta_prim <- J^-1 (-residual)
+                            solve_small(jacobian, delta_prim, nfvar, use_qr, tiny);
                             // Check for positive definite values of density and internal energy.
                             // Ignore zone if manual backtracking is not sufficient.
                             // The primitives will be averaged over good neighbors.
@@ -506,7 +498,7 @@ TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_
 
                                         // Compute solve_norm of the residual (loss function)
                                         calc_residual(G, P_linesearch, P_full_step_init, U_full_step_init, P_sub_step_init, flux_src,
-                                                    dU_implicit, tmp3, m_p, m_u, emhd_params_linesearch, emhd_params_solver, nfvar,
+                                                    dU_implicit, tmp3, m_p, m_u, emhd_params_solver, emhd_params_solver, nfvar,
                                                     k, j, i, gam, dt, residual);
 
                                         solve_norm()        = 0;
@@ -541,6 +533,31 @@ TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_
                                 if (solve_norm() > rootfind_tol) {
                                     solve_fail() = SolverStatus::beyond_tol; // TODO was changed from +=. Valid?
                                 }
+
+                                if (quasi_newton) {
+                                    if (broyden) {
+                                        // Rank-1 update matching the step we just took, dx = lambda * delta_prim:
+                                        // J += ((r_new - r_old) - J dx) dx^T / (dx . dx)
+                                        Real dx_sq = 0.;
+                                        FLOOP dx_sq += lambda * delta_prim(ip) * lambda * delta_prim(ip);
+                                        if (dx_sq > 0.) {
+                                            FLOOP {
+                                                Real coeff = residual(ip) - tmp2(ip);
+                                                for (int jp = 0; jp < nfvar; ++jp)
+                                                    coeff -= jacobian(ip, jp) * lambda * delta_prim(jp);
+                                                coeff /= dx_sq;
+                                                for (int jp = 0; jp < nfvar; ++jp)
+                                                    jacobian(ip, jp) += coeff * lambda * delta_prim(jp);
+                                            }
+                                        }
+                                    }
+                                    if (fresh_jac || broyden) {
+                                        FLOOP for (int jp = 0; jp < nfvar; ++jp)
+                                            solve_jacobian_all(b, ip*nfvar + jp, k, j, i) = jacobian(ip, jp);
+                                    }
+                                    // Start over with a fresh Jacobian if this iteration stalled
+                                    solve_refresh_all(b, 0, k, j, i) = (solve_norm() > refresh_ratio * norm_start);
+                                }
                             }
                         }
                     }
@@ -595,8 +612,8 @@ TaskStatus Implicit::Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_
                 }
             }
 
-            // Finally, break if max_norm is less than the total tolerance we set
-            // TODO per-zone tolerance with masks?
+            // Finally, break if max_norm is less than the total tolerance we set,
+            // i.e. every zone has either converged or failed
             if (iter >= iter_min && max_norm < rootfind_tol) {
                 EndFlag();
                 break;
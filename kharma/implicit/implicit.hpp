@@ -73,6 +73,12 @@ static const std::map<int, std::string> status_names = {
     {(int) SolverStatus::backtrack, "backtrack"}
 };
 
+// How the Jacobian is obtained on iterations after the first, see <implicit>/jacobian_update
+// `newton`: recompute every iteration
+// `reuse`: keep the first Jacobian of the sub-step
+// `broyden`: apply a rank-1 Broyden update to the previous Jacobian
+enum class JacobianUpdate{newton=0, reuse, broyden};
+
 template <typename T>
 KOKKOS_INLINE_FUNCTION bool failed(T status_flag)
 {
@@ -92,11 +98,10 @@ std::shared_ptr<KHARMAPackage> Initialize(ParameterInput *pin, std::shared_ptr<P
  * @param md_sub_step_init the initial fluid state for this substep
  * @param md_flux_src the negative flux divergence plus explicit source terms
  * @param md_solver should contain initial guess on call, contains result on return
- * @param md_linesearch should contain solver prims at start, updated in the linesearch
  * @param dt the timestep (current substep)
  */
 TaskStatus Step(MeshData<Real> *md_full_step_init, MeshData<Real> *md_sub_step_init, MeshData<Real> *md_flux_src,
-                MeshData<Real> *md_linesearch, MeshData<Real> *md_solver, const Real& dt);
+                MeshData<Real> *md_solver, const Real& dt);
 
 /**
  * Get the names of all variables matching 'flag' in a deterministic order, placing implicitly-evolved variables first.
@@ -124,16 +129,27 @@ inline TaskStatus MeshFixSolve(MeshData<Real> *md) {
  */
 TaskStatus PostStepDiagnostics(const SimTime& tm, MeshData<Real> *md);
 
+/**
+ * Read-only access to all variables of one zone of a VariablePack, addressable var(ip)
+ * like a sliced scratchpad.  Lets the solver read its inputs directly from their packs.
+ */
+struct PackZone {
+    const VariablePack<Real>& pack;
+    const int k, j, i;
+
+    KOKKOS_FORCEINLINE_FUNCTION const Real& operator()(const int& ip) const { return pack(ip, k, j, i); }
+};
+
 /**
  * Calculate the residual generated by the trial primitives P_test
  * 
- * "Global" here are read-only input arrays addressed var(ip, k, j, i)
  * "Local" here is anything sliced (usually Scratch) addressable var(ip)
+ * "Input" is the same, but read-only (usually a PackZone)
  */
-template<typename Local>
+template<typename Local, typename Input>
 KOKKOS_INLINE_FUNCTION void calc_residual(const GRCoordinates& G, const Local& P_test,
-                                          const Local& Pi, const Local& Ui, const Local& Ps,
-                                          const Local& dudt_explicit, const Local& dUi, const Local& tmp, 
+                                          const Input& Pi, const Input& Ui, const Input& Ps,
+                                          const Input& dudt_explicit, const Local& dUi, const Local& tmp, 
                                           const VarMap& m_p, const VarMap& m_u, const EMHD_parameters& emhd_params,
                                           const EMHD_parameters& emhd_params_s,const int& nfvar, 
                                           const int& k, const int& j, const int& i, 
@@ -188,12 +204,12 @@ KOKKOS_INLINE_FUNCTION void calc_residual(const GRCoordinates& G, const Local& P
  * Evaluate the jacobian for the implicit iteration, in one zone
  * 
  * Local is anything addressable by (0:nvar-1), Local2 is the same for 2D (0:nvar-1, 0:nvar-1)
- * Usually these are Kokkos subviews
+ * Usually these are Kokkos subviews.  Input is a read-only Local, usually a PackZone
  */
-template<typename Local, typename Local2>
+template<typename Local, typename Local2, typename Input>
 KOKKOS_INLINE_FUNCTION void calc_jacobian(const GRCoordinates& G, const Local& P_solver,
-                                          const Local& P_full_step_init, const Local& U_full_step_init, const Local& P_sub_step_init,
-                                          const Local& flux_src, const Local& dU_implicit, Local& tmp1, Local& tmp2, Local& tmp3,
+                                          const Input& P_full_step_init, const Input& U_full_step_init, const Input& P_sub_step_init,
+                                          const Input& flux_src, const Local& dU_implicit, Local& tmp1, Local& tmp2, Local& tmp3,
                                           const VarMap& m_p, const VarMap& m_u, const EMHD_parameters& emhd_params_solver,
                                           const EMHD_parameters& emhd_params_sub_step_init, const int& nvar, const int& nfvar,
                                           const int& k, const int& j, const int& i,
@@ -0,0 +1,450 @@
+/* 
+ *  File: implicit_ad.hpp
+ *  
+ *  BSD 3-Clause License
+ *  
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *  
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *  
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *  
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "decs.hpp"
+#include "types.hpp"
+
+#include "emhd.hpp"
+#include "grmhd_functions.hpp"
+
+/**
+ * Forward-mode automatic differentiation of the implicit residual.
+ *
+ * Rather than perturbing each implicit primitive in turn (see Implicit::calc_jacobian), we
+ * evaluate the residual once in dual numbers, which carry their derivative w.r.t. every
+ * implicit primitive along with their value.  This yields the residual and the full Jacobian
+ * in one pass, exact to roundoff and independent of jacobian_delta.
+ *
+ * The functions here mirror Flux::p_to_u, EMHD::implicit_sources and
+ * EMHD::time_derivative_sources term for term, and must be kept in sync with them.
+ * Anything evaluated at the sub-step initial state (tau, chi_e, nu_e, the EMHD normalization)
+ * is constant during the solve, so it stays a plain Real.
+ */
+
+// Maximum number of implicitly-evolved variables the dual numbers can carry:
+// enough for rho, u, uvec, q, dP.  Checked in Implicit::Initialize.
+#define IMPLICIT_AD_NVAR 7
+
+namespace Implicit
+{
+
+/**
+ * Dual number: a value and its gradient w.r.t. N independent variables
+ */
+template<int N>
+struct Dual {
+    Real v;
+    Real d[N];
+
+    KOKKOS_INLINE_FUNCTION Dual() : v(0.) { for (int n = 0; n < N; ++n) d[n] = 0.; }
+    KOKKOS_INLINE_FUNCTION Dual(const Real& val) : v(val) { for (int n = 0; n < N; ++n) d[n] = 0.; }
+
+    // Independent variable number n
+    KOKKOS_INLINE_FUNCTION static Dual seed(const Real& val, const int& n)
+    {
+        Dual out(val);
+        out.d[n] = 1.;
+        return out;
+    }
+
+    KOKKOS_INLINE_FUNCTION Dual& operator+=(const Dual& b)
+    {
+        v += b.v;
+        for (int n = 0; n < N; ++n) d[n] += b.d[n];
+        return *this;
+    }
+    KOKKOS_INLINE_FUNCTION Dual& operator-=(const Dual& b)
+    {
+        v -= b.v;
+        for (int n = 0; n < N; ++n) d[n] -= b.d[n];
+        return *this;
+    }
+    KOKKOS_INLINE_FUNCTION Dual& operator*=(const Dual& b)
+    {
+        for (int n = 0; n < N; ++n) d[n] = d[n] * b.v + v * b.d[n];
+        v *= b.v;
+        return *this;
+    }
+    KOKKOS_INLINE_FUNCTION Dual& operator+=(const Real& b) { v += b; return *this; }
+    KOKKOS_INLINE_FUNCTION Dual& operator-=(const Real& b) { v -= b; return *this; }
+    KOKKOS_INLINE_FUNCTION Dual& operator*=(const Real& b)
+    {
+        v *= b;
+        for (int n = 0; n < N; ++n) d[n] *= b;
+        return *this;
+    }
+};
+
+template<int N>
+KOKKOS_INLINE_FUNCTION Dual<N> operator-(const Dual<N>& a)
+{
+    Dual<N> out(-a.v);
+    for (int n = 0; n < N; ++n) out.d[n] = -a.d[n];
+    return out;
+}
+template<int N>
+KOKKOS_INLINE_FUNCTION Dual<N> operator+(Dual<N> a, const Dual<N>& b) { return a += b; }
+template<int N>
+KOKKOS_INLINE_FUNCTION Dual<N> operator+(Dual<N> a, const Real& b) { return a += b; }
+template<int N>
+KOKKOS_INLINE_FUNCTION Dual<N> operator+(const Real& a, Dual<N> b) { return b += a; }
+template<int N>
+KOKKOS_INLINE_FUNCTION Dual<N> operator-(Dual<N> a, const Dual<N>& b) { return a -= b; }
+template<int N>
+KOKKOS_INLINE_FUNCTION Dual<N> operator-(Dual<N> a, const Real& b) { return a -= b; }
+template<int N>
+KOKKOS_INLINE_FUNCTION Dual<N> operator-(const Real& a, const Dual<N>& b) { return -b + a; }
+template<int N>
+KOKKOS_INLINE_FUNCTION Dual<N> operator*(Dual<N> a, const Dual<N>& b) { return a *= b; }
+template<int N>
+KOKKOS_INLINE_FUNCTION Dual<N> operator*(Dual<N> a, const Real& b) { return a *= b; }
+template<int N>
+KOKKOS_INLINE_FUNCTION Dual<N> operator*(const Real& a, Dual<N> b) { return b *= a; }
+template<int N>
+KOKKOS_INLINE_FUNCTION Dual<N> operator/(const Dual<N>& a, const Dual<N>& b)
+{
+    Dual<N> out(a.v / b.v);
+    for (int n = 0; n < N; ++n) out.d[n] = (a.d[n] - out.v * b.d[n]) / b.v;
+    return out;
+}
+template<int N>
+KOKKOS_INLINE_FUNCTION Dual<N> operator/(Dual<N> a, const Real& b) { return a *= 1. / b; }
+template<int N>
+KOKKOS_INLINE_FUNCTION Dual<N> operator/(const Real& a, const Dual<N>& b) { return Dual<N>(a) / b; }
+
+template<int N>
+KOKKOS_INLINE_FUNCTION Dual<N> sqrt(const Dual<N>& a)
+{
+    Dual<N> out(m::sqrt(a.v));
+    for (int n = 0; n < N; ++n) out.d[n] = 0.5 * a.d[n] / out.v;
+    return out;
+}
+// Floors are constant wherever they apply, as in the finite-difference version
+template<int N>
+KOKKOS_INLINE_FUNCTION Dual<N> max(const Dual<N>& a, const Real& b)
+{
+    return (a.v >= b) ? a : Dual<N>(b);
+}
+
+using ADReal = Dual<IMPLICIT_AD_NVAR>;
+
+struct ADFourVectors {
+    ADReal ucon[GR_DIM];
+    ADReal ucov[GR_DIM];
+    ADReal bcon[GR_DIM];
+    ADReal bcov[GR_DIM];
+};
+
+/**
+ * Primitive ip of P as a dual number.  Implicit variables (ip < nfvar) are the
+ * independent variables, anything else is held constant.
+ */
+template<typename Local>
+KOKKOS_INLINE_FUNCTION ADReal ad_prim(const Local& P, const int& ip, const int& nfvar)
+{
+    return (ip < nfvar) ? ADReal::seed(P(ip), ip) : ADReal(P(ip));
+}
+
+KOKKOS_INLINE_FUNCTION ADReal ad_dot(const ADReal v1[GR_DIM], const ADReal v2[GR_DIM])
+{
+    return v1[0]*v2[0] + v1[1]*v2[1] + v1[2]*v2[2] + v1[3]*v2[3];
+}
+
+KOKKOS_INLINE_FUNCTION void ad_lower(const GRCoordinates& G, const ADReal vcon[GR_DIM], ADReal vcov[GR_DIM],
+                                     const int& j, const int& i)
+{
+    DLOOP1 vcov[mu] = 0.;
+    DLOOP2 vcov[mu] += G.gcov(Loci::center, j, i, mu, nu) * vcon[nu];
+}
+
+/**
+ * Dual version of GRMHD::calc_4vecs, at zone centers
+ */
+template<typename Local>
+KOKKOS_INLINE_FUNCTION void ad_calc_4vecs(const GRCoordinates& G, const Local& P, const VarMap& m_p, const int& nfvar,
+                                          const int& j, const int& i, ADFourVectors& D)
+{
+    ADReal uvec[NVEC];
+    VLOOP uvec[v] = ad_prim(P, m_p.U1 + v, nfvar);
+    ADReal qsq = 0.;
+    VLOOP2 qsq += G.gcov(Loci::center, j, i, v+1, w+1) * uvec[v] * uvec[w];
+    const ADReal gamma = sqrt(1. + qsq);
+    const Real alpha = 1. / m::sqrt(-G.gcon(Loci::center, j, i, 0, 0));
+
+    D.ucon[0] = gamma / alpha;
+    VLOOP D.ucon[v+1] = uvec[v] - gamma * alpha * G.gcon(Loci::center, j, i, 0, v+1);
+
+    ad_lower(G, D.ucon, D.ucov, j, i);
+
+    if (m_p.B1 >= 0) {
+        ADReal B_P[NVEC];
+        VLOOP B_P[v] = ad_prim(P, m_p.B1 + v, nfvar);
+        D.bcon[0] = 0.;
+        VLOOP D.bcon[0] += B_P[v] * D.ucov[v+1];
+        VLOOP D.bcon[v+1] = (B_P[v] + D.bcon[0] * D.ucon[v+1]) / D.ucon[0];
+
+        ad_lower(G, D.bcon, D.bcov, j, i);
+    } else {
+        DLOOP1 D.bcon[mu] = D.bcov[mu] = 0.;
+    }
+}
+
+/**
+ * Dual version of Flux::calc_tensor, for the time component T^0_mu only.
+ * With no B field, bcon == 0 and the GRMHD form reduces to GRHD.
+ */
+template<typename Local>
+KOKKOS_INLINE_FUNCTION void ad_calc_tensor(const Local& P, const VarMap& m_p, const ADFourVectors& D,
+                                           const EMHD::EMHD_parameters& emhd_params, const Real& gam, const int& nfvar,
+                                           ADReal T[GR_DIM])
+{
+    const ADReal rho  = ad_prim(P, m_p.RHO, nfvar);
+    const ADReal u    = ad_prim(P, m_p.UU, nfvar);
+    const ADReal pgas = (gam - 1.) * u;
+
+    if (m_p.Q >= 0 || m_p.DP >= 0) {
+        // See EMHD::convert_prims_to_q_dP
+        const ADReal Theta = pgas / rho;
+        const ADReal cs2   = gam * pgas / (rho + gam * u);
+        ADReal q = 0., dP = 0.;
+        if (emhd_params.conduction) {
+            q = ad_prim(P, m_p.Q, nfvar);
+            if (emhd_params.higher_order_terms) {
+                if (emhd_params.type == EMHD::ClosureType::kappa_eta)
+                    q *= sqrt(emhd_params.kappa * Theta * Theta / emhd_params.tau);
+                else
+                    q *= sqrt(rho * emhd_params.conduction_alpha * cs2 * Theta * Theta);
+            }
+        }
+        if (emhd_params.viscosity) {
+            dP = ad_prim(P, m_p.DP, nfvar);
+            if (emhd_params.higher_order_terms) {
+                if (emhd_params.type == EMHD::ClosureType::kappa_eta)
+                    dP *= sqrt(emhd_params.eta * Theta / emhd_params.tau);
+                else
+                    dP *= sqrt(rho * emhd_params.viscosity_alpha * cs2 * Theta);
+            }
+        }
+
+        // See EMHD::calc_tensor
+        const ADReal bsq   = max(ad_dot(D.bcon, D.bcov), SMALL);
+        const ADReal b_mag = sqrt(bsq);
+        const ADReal eta   = pgas + rho + u + bsq;
+        const ADReal ptot  = pgas + 0.5 * bsq;
+
+        DLOOP1 T[mu] = eta * D.ucon[0] * D.ucov[mu] - D.bcon[0] * D.bcov[mu];
+        T[0] += ptot;
+
+        if (emhd_params.feedback) {
+            if (emhd_params.conduction)
+                DLOOP1
+                    T[mu] += (q / b_mag) * ((D.ucon[0] * D.bcov[mu]) + (D.bcon[0] * D.ucov[mu]));
+            if (emhd_params.viscosity) {
+                DLOOP1
+                    T[mu] -= dP * ((D.bcon[0] * D.bcov[mu] / bsq) - (1./3.) * (D.ucon[0] * D.ucov[mu]));
+                T[0] += (1./3.) * dP;
+            }
+        }
+    } else {
+        const ADReal bsq  = ad_dot(D.bcon, D.bcov);
+        const ADReal eta  = pgas + rho + u + bsq;
+        const ADReal ptot = pgas + 0.5 * bsq;
+
+        DLOOP1 T[mu] = eta * D.ucon[0] * D.ucov[mu] - D.bcon[0] * D.bcov[mu];
+        T[0] += ptot;
+    }
+}
+
+/**
+ * Dual version of Flux::p_to_u, filling only the implicit conserved variables (iu < nfvar)
+ */
+template<typename Local>
+KOKKOS_INLINE_FUNCTION void ad_p_to_u(const GRCoordinates& G, const Local& P, const VarMap& m_p, const ADFourVectors& D,
+                                      const EMHD::EMHD_parameters& emhd_params, const Real& gam, const int& nfvar,
+                                      const int& j, const int& i, ADReal U[IMPLICIT_AD_NVAR], const VarMap& m_u)
+{
+    const Real gdet = G.gdet(Loci::center, j, i);
+    auto set = [&](const int& iu, const ADReal& val) { if (iu >= 0 && iu < nfvar) U[iu] = val; };
+
+    // Particle number flux
+    const ADReal U_rho = ad_prim(P, m_p.RHO, nfvar) * D.ucon[0] * gdet;
+    set(m_u.RHO, U_rho);
+
+    // Stress-energy tensor
+    ADReal T[GR_DIM];
+    ad_calc_tensor(P, m_p, D, emhd_params, gam, nfvar, T);
+    set(m_u.UU, T[0] * gdet + U_rho);
+    VLOOP set(m_u.U1 + v, T[v+1] * gdet);
+
+    // Magnetic field & constraint damping scalar
+    if (m_u.B1 >= 0) {
+        VLOOP set(m_u.B1 + v, ad_prim(P, m_p.B1 + v, nfvar) * gdet);
+        if (m_u.PSI >= 0)
+            set(m_u.PSI, ad_prim(P, m_p.PSI, nfvar) * gdet);
+    }
+
+    // EMHD Variables: advect like rho
+    if (m_u.Q >= 0)
+        set(m_u.Q, ad_prim(P, m_p.Q, nfvar) * D.ucon[0] * gdet);
+    if (m_u.DP >= 0)
+        set(m_u.DP, ad_prim(P, m_p.DP, nfvar) * D.ucon[0] * gdet);
+
+    // Electrons: normalized by density
+    if (m_u.KTOT >= 0) {
+        set(m_u.KTOT, U_rho * ad_prim(P, m_p.KTOT, nfvar));
+        if (m_u.K_CONSTANT >= 0)
+            set(m_u.K_CONSTANT, U_rho * ad_prim(P, m_p.K_CONSTANT, nfvar));
+        if (m_u.K_HOWES >= 0)
+            set(m_u.K_HOWES, U_rho * ad_prim(P, m_p.K_HOWES, nfvar));
+        if (m_u.K_KAWAZURA >= 0)
+            set(m_u.K_KAWAZURA, U_rho * ad_prim(P, m_p.K_KAWAZURA, nfvar));
+        if (m_u.K_WERNER >= 0)
+            set(m_u.K_WERNER, U_rho * ad_prim(P, m_p.K_WERNER, nfvar));
+        if (m_u.K_ROWAN >= 0)
+            set(m_u.K_ROWAN, U_rho * ad_prim(P, m_p.K_ROWAN, nfvar));
+        if (m_u.K_SHARMA >= 0)
+            set(m_u.K_SHARMA, U_rho * ad_prim(P, m_p.K_SHARMA, nfvar));
+    }
+}
+
+/**
+ * Evaluate the residual and the Jacobian for the implicit iteration in one zone,
+ * by forward-mode automatic differentiation.
+ * Arguments and results are as for calc_jacobian, which this replaces when
+ * <implicit>/jacobian=analytic.  No temporaries are needed.
+ */
+template<typename Local, typename Local2, typename Input>
+KOKKOS_INLINE_FUNCTION void calc_jacobian_ad(const GRCoordinates& G, const Local& P_solver,
+                                             const Input& P_full_step_init, const Input& U_full_step_init, const Input& P_sub_step_init,
+                                             const Input& flux_src, const Local& dU_implicit,
+                                             const VarMap& m_p, const VarMap& m_u, const EMHD::EMHD_parameters& emhd_params_solver,
+                                             const EMHD::EMHD_parameters& emhd_params_sub_step_init, const int& nfvar,
+                                             const int& k, const int& j, const int& i,
+                                             const Real& gam, const double& dt,
+                                             Local2& jacobian, Local& residual)
+{
+    // Shorter names, as in calc_residual
+    const auto& Pi = P_full_step_init;
+    const auto& Ps = P_sub_step_init;
+    const auto& emhd_params_s = emhd_params_sub_step_init;
+
+    // (U_test - Ui)/dt - dudt_explicit ...
+    ADFourVectors D;
+    ad_calc_4vecs(G, P_solver, m_p, nfvar, j, i, D);
+    ADReal res[IMPLICIT_AD_NVAR];
+    ad_p_to_u(G, P_solver, m_p, D, emhd_params_solver, gam, nfvar, j, i, res, m_u);
+    FLOOP res[ip] = (res[ip] - U_full_step_init(ip)) / dt - flux_src(ip);
+
+    if (m_p.Q >= 0 || m_p.DP >= 0) {
+        const Real gdet = G.gdet(Loci::center, j, i);
+        Real tau, chi_e, nu_e;
+        EMHD::set_parameters(G, Ps, m_p, emhd_params_s, gam, j, i, tau, chi_e, nu_e);
+
+        // ... - 0.5*(dU_new(ip) + dUi(ip)) ...
+        // See EMHD::implicit_sources
+        if (emhd_params_solver.conduction)
+            res[m_u.Q] -= 0.5*(-gdet * ad_prim(P_solver, m_p.Q, nfvar) / tau + dU_implicit(m_u.Q));
+        if (emhd_params_solver.viscosity)
+            res[m_u.DP] -= 0.5*(-gdet * ad_prim(P_solver, m_p.DP, nfvar) / tau + dU_implicit(m_u.DP));
+
+        // ... - dU_time(ip)
+        // See EMHD::time_derivative_sources.  Only the "new" 4-velocity & temperature vary
+        FourVectors Ds;
+        GRMHD::calc_4vecs(G, Ps, m_p, j, i, Loci::center, Ds);
+        const Real bsq   = m::max(dot(Ds.bcon, Ds.bcov), SMALL);
+        const Real mag_b = m::sqrt(bsq);
+
+        Real ucon_old[GR_DIM], ucov_old[GR_DIM];
+        GRMHD::calc_ucon(G, Pi, m_p, j, i, Loci::center, ucon_old);
+        G.lower(ucon_old, ucov_old, 0, j, i, Loci::center);
+        ADReal dt_ucov[GR_DIM];
+        DLOOP1 dt_ucov[mu] = (D.ucov[mu] - ucov_old[mu]) / dt;
+
+        ADReal div_ucon = 0.;
+        DLOOP1 div_ucon += G.gcon(Loci::center, j, i, 0, mu) * dt_ucov[mu];
+        const ADReal Theta_new = max((gam-1) * ad_prim(P_solver, m_p.UU, nfvar) / ad_prim(P_solver, m_p.RHO, nfvar), SMALL);
+        const Real Theta_old   = m::max((gam-1) * Pi(m_p.UU) / Pi(m_p.RHO), SMALL);
+        const ADReal dt_Theta  = (Theta_new - Theta_old) / dt;
+
+        const Real rho   = Ps(m_p.RHO);
+        const Real Theta = (gam-1) * Ps(m_p.UU) / Ps(m_p.RHO);
+
+        if (emhd_params_s.conduction) {
+            ADReal q0 = -rho * chi_e * (Ds.bcon[0] / mag_b) * dt_Theta;
+            DLOOP1 q0 -= rho * chi_e * (Ds.bcon[mu] / mag_b) * Theta * Ds.ucon[0] * dt_ucov[mu];
+            if (emhd_params_s.higher_order_terms)
+                q0 *= (chi_e != 0) ? m::sqrt(tau / (chi_e * rho * Theta * Theta)) : 0.0;
+
+            ADReal dUq = gdet * (q0 / tau);
+            if (emhd_params_s.higher_order_terms)
+                dUq += gdet * (Ps(m_p.Q) / 2.) * div_ucon;
+            if (emhd_params_solver.conduction)
+                res[m_u.Q] -= dUq;
+        }
+
+        if (emhd_params_s.viscosity) {
+            ADReal dP0 = -rho * nu_e * div_ucon;
+            DLOOP1 dP0 += 3. * rho * nu_e * (Ds.bcon[0] * Ds.bcon[mu] / bsq) * dt_ucov[mu];
+            if (emhd_params_s.higher_order_terms)
+                dP0 *= (nu_e != 0) ? m::sqrt(tau / (nu_e * rho * Theta)) : 0.0;
+
+            ADReal dUdP = gdet * (dP0 / tau);
+            if (emhd_params_s.higher_order_terms)
+                dUdP += gdet * (Ps(m_p.DP) / 2.) * div_ucon;
+            if (emhd_params_solver.viscosity)
+                res[m_u.DP] -= dUdP;
+        }
+
+        // Normalize
+        if (emhd_params_solver.conduction)
+            res[m_u.Q] *= tau;
+        if (emhd_params_solver.viscosity)
+            res[m_u.DP] *= tau;
+        if (emhd_params_solver.higher_order_terms) {
+            if (emhd_params_solver.conduction)
+                res[m_u.Q] *= (chi_e != 0) ? m::sqrt(rho * chi_e * tau * Theta * Theta) / tau : 1.;
+            if (emhd_params_solver.viscosity)
+                res[m_u.DP] *= (nu_e != 0) ? m::sqrt(rho * nu_e * tau * Theta) / tau : 1.;
+        }
+    }
+
+    FLOOP {
+        residual(ip) = res[ip].v;
+        for (int col = 0; col < nfvar; col++)
+            jacobian(ip, col) = res[ip].d[col];
+    }
+}
+
+} // namespace Implicit
@@ -0,0 +1,203 @@
+/* 
+ *  File: linear_solve.hpp
+ *  
+ *  BSD 3-Clause License
+ *  
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *  
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *  
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *  
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "decs.hpp"
+
+/**
+ * Small dense linear solves for the implicit step, one per zone.
+ *
+ * The systems are tiny (5-7 rows for GRMHD+EMHD), so rather than general batched
+ * routines on scratch views we copy each system to a local fixed-size array and
+ * solve it there.  Sizes are template parameters, so for the common counts of
+ * implicit variables every loop has a compile-time trip count and can be fully
+ * unrolled, keeping the whole solve in registers.
+ */
+
+// Largest system handled by the generic (runtime-size) fallback.
+// Checked in Implicit::Initialize.
+#define IMPLICIT_MAX_NVAR 20
+
+namespace Implicit
+{
+
+/**
+ * Solve A x = b in place by LU decomposition with partial pivoting.
+ * Pivots smaller than tiny are replaced by +-tiny, as in KokkosBatched::SerialLU.
+ * On return b contains x.  Only the leading n x n block of A is used.
+ */
+template<int N>
+KOKKOS_INLINE_FUNCTION void lu_solve(Real A[N][N], Real b[N], const Real& tiny, const int n=N)
+{
+    for (int c = 0; c < n; ++c) {
+        // Find the pivot row & swap it into place
+        int p = c;
+        for (int r = c+1; r < n; ++r)
+            if (m::abs(A[r][c]) > m::abs(A[p][c])) p = r;
+        if (p != c) {
+            for (int cc = 0; cc < n; ++cc) {
+                const Real t = A[c][cc]; A[c][cc] = A[p][cc]; A[p][cc] = t;
+            }
+            const Real t = b[c]; b[c] = b[p]; b[p] = t;
+        }
+        if (m::abs(A[c][c]) < tiny)
+            A[c][c] = (A[c][c] < 0.) ? -tiny : tiny;
+
+        // Eliminate below the diagonal, applying the same operations to b
+        for (int r = c+1; r < n; ++r) {
+            const Real l = A[r][c] / A[c][c];
+            for (int cc = c+1; cc < n; ++cc)
+                A[r][cc] -= l * A[c][cc];
+            b[r] -= l * b[c];
+        }
+    }
+    // Back-substitute against U
+    for (int r = n-1; r >= 0; --r) {
+        for (int c = r+1; c < n; ++c)
+            b[r] -= A[r][c] * b[c];
+        b[r] /= A[r][r];
+    }
+}
+
+/**
+ * Solve A x = b in place by Householder QR decomposition with column pivoting.
+ * Diagonal entries of R smaller than tiny are replaced by +-tiny, as in lu_solve.
+ * On return b contains x.  Only the leading n x n block of A is used.
+ */
+template<int N>
+KOKKOS_INLINE_FUNCTION void qr_solve(Real A[N][N], Real b[N], const Real& tiny, const int n=N)
+{
+    int perm[N];
+    for (int c = 0; c < n; ++c) perm[c] = c;
+
+    for (int c = 0; c < n; ++c) {
+        // Pivot the column with the largest remaining norm into place
+        int p = c;
+        Real max_norm = -1.;
+        for (int cc = c; cc < n; ++cc) {
+            Real norm = 0.;
+            for (int r = c; r < n; ++r) norm += A[r][cc] * A[r][cc];
+            if (norm > max_norm) { max_norm = norm; p = cc; }
+        }
+        if (p != c) {
+            for (int r = 0; r < n; ++r) {
+                const Real t = A[r][c]; A[r][c] = A[r][p]; A[r][p] = t;
+            }
+            const int t = perm[c]; perm[c] = perm[p]; perm[p] = t;
+        }
+
+        // Householder reflection v zeroing column c below the diagonal
+        const Real alpha = (A[c][c] > 0.) ? -m::sqrt(max_norm) : m::sqrt(max_norm);
+        Real v[N];
+        Real v_norm = 0.;
+        for (int r = c; r < n; ++r) {
+            v[r] = A[r][c] - (r == c) * alpha;
+            v_norm += v[r] * v[r];
+        }
+        if (v_norm > 0.) {
+            // Apply I - 2 v v^T / |v|^2 to the remaining columns and to b
+            for (int cc = c+1; cc < n; ++cc) {
+                Real s = 0.;
+                for (int r = c; r < n; ++r) s += v[r] * A[r][cc];
+                s *= 2. / v_norm;
+                for (int r = c; r < n; ++r) A[r][cc] -= s * v[r];
+            }
+            Real s = 0.;
+            for (int r = c; r < n; ++r) s += v[r] * b[r];
+            s *= 2. / v_norm;
+            for (int r = c; r < n; ++r) b[r] -= s * v[r];
+            A[c][c] = alpha;
+        }
+    }
+
+    // Back-substitute against R, then undo the column permutation
+    Real x[N];
+    for (int r = n-1; r >= 0; --r) {
+        x[r] = b[r];
+        for (int c = r+1; c < n; ++c)
+            x[r] -= A[r][c] * x[c];
+        if (m::abs(A[r][r]) < tiny)
+            A[r][r] = (A[r][r] < 0.) ? -tiny : tiny;
+        x[r] /= A[r][r];
+    }
+    for (int c = 0; c < n; ++c) b[perm[c]] = x[c];
+}
+
+/**
+ * Copy the system jacobian * x = rhs into registers, solve it, and write x back to rhs.
+ * Local2 is anything addressable (row, col), Local is addressable (row).
+ */
+template<int N, typename Local2, typename Local>
+KOKKOS_INLINE_FUNCTION void solve_fixed(const Local2& jacobian, const Local& rhs, const bool& use_qr,
+                                        const Real& tiny, const int n=N)
+{
+    Real A[N][N], b[N];
+    for (int r = 0; r < n; ++r) {
+        for (int c = 0; c < n; ++c)
+            A[r][c] = jacobian(r, c);
+        b[r] = rhs(r);
+    }
+    if (use_qr) {
+        qr_solve<N>(A, b, tiny, n);
+    } else {
+        lu_solve<N>(A, b, tiny, n);
+    }
+    for (int r = 0; r < n; ++r) rhs(r) = b[r];
+}
+
+/**
+ * Solve the per-zone system of nfvar equations, dispatching to a fixed-size solver.
+ * GRMHD evolves 5 variables implicitly, plus one each for heat conduction & viscosity:
+ * those sizes get their own fully-unrolled versions, anything else uses a generic one.
+ */
+template<typename Local2, typename Local>
+KOKKOS_INLINE_FUNCTION void solve_small(const Local2& jacobian, const Local& rhs, const int& nfvar,
+                                        const bool& use_qr, const Real& tiny)
+{
+    switch (nfvar) {
+    case 5:
+        solve_fixed<5>(jacobian, rhs, use_qr, tiny);
+        break;
+    case 6:
+        solve_fixed<6>(jacobian, rhs, use_qr, tiny);
+        break;
+    case 7:
+        solve_fixed<7>(jacobian, rhs, use_qr, tiny);
+        break;
+    default:
+        solve_fixed<IMPLICIT_MAX_NVAR>(jacobian, rhs, use_qr, tiny, nfvar);
+    }
+}
+
+} // namespace Implicit
@@ -73,50 +73,79 @@ TaskStatus Inverter::FixUtoP(MeshBlockData<Real> *rc)
     // but before physical boundary zones are computed (which it should never use anyway)
 
     const IndexRange3 b = KDomain::GetPhysicalRange(rc);
+    const int ni = b.ie - b.is + 1;
+    const int nj = b.je - b.js + 1;
+    const int nk = b.ke - b.ks + 1;
 
     const auto& G = pmb->coords;
 
-    pmb->par_for("fix_U_to_P", b.ks, b.ke, b.js, b.je, b.is, b.ie,
-        KOKKOS_LAMBDA (const int &k, const int &j, const int &i) {
+    // Failures are rare, so first compact the list of failed zones, then do the (much more expensive)
+    // neighbor averaging and floors only there.  The list holds flattened indices over the physical range
+    int nfailed = 0;
+    Kokkos::parallel_reduce("count_U_to_P_failures", Kokkos::RangePolicy<>(pmb->exec_space, 0, nk*nj*ni),
+        KOKKOS_LAMBDA (const int &idx, int &n) {
+            const int k = b.ks + idx / (nj*ni);
+            const int j = b.js + (idx / ni) % nj;
+            const int i = b.is + idx % ni;
+            if (failed(pflag(k, j, i))) ++n;
+        }, nfailed);
+    if (nfailed == 0) {
+        EndFlag();
+        return TaskStatus::complete;
+    }
+    ParArray1D<int> failed_zones("failed_zones", nfailed);
+    Kokkos::parallel_scan("list_U_to_P_failures", Kokkos::RangePolicy<>(pmb->exec_space, 0, nk*nj*ni),
+        KOKKOS_LAMBDA (const int &idx, int &n, const bool &final) {
+            const int k = b.ks + idx / (nj*ni);
+            const int j = b.js + (idx / ni) % nj;
+            const int i = b.is + idx % ni;
             if (failed(pflag(k, j, i))) {
-                // Luckily fixups are rare, so we don't have to worry about optimizing this *too* much
-                double wsum = 0., wsum_x = 0.;
-                double sum[NPRIM] = {0.}, sum_x[NPRIM] = {0.};
-                // For all neighboring cells...
-                for (int n = -1; n <= 1; n++) {
-                    for (int m = -1; m <= 1; m++) {
-                        for (int l = -1; l <= 1; l++) {
-                            int ii = i + l, jj = j + m, kk = k + n;
-                            // If we haven't overstepped array bounds...
-                            if (KDomain::inside(kk, jj, ii, b)) {
-                                // Weight by distance
-                                double w = 1./(m::abs(l) + m::abs(m) + m::abs(n) + 1);
-
-                                // Count only the good cells (not failed AND not corner), if we can
-                                if (!failed(pflag(kk, jj, ii))) {
-                                    // Weight by distance.  Note interpolated "fixed" cells stay flagged
-                                    wsum += w;
-                                    PRIMLOOP sum[p] += w * P(p, kk, jj, ii);
-                                }
-                                // Just in case, keep a sum of even the bad ones
-                                wsum_x += w;
-                                PRIMLOOP sum_x[p] += w * P(p, kk, jj, ii);
+                if (final) failed_zones(n) = idx;
+                ++n;
+            }
+        });
+
+    pmb->par_for("fix_U_to_P", 0, nfailed-1,
+        KOKKOS_LAMBDA (const int &f) {
+            const int k = b.ks + failed_zones(f) / (nj*ni);
+            const int j = b.js + (failed_zones(f) / ni) % nj;
+            const int i = b.is + failed_zones(f) % ni;
+            double wsum = 0., wsum_x = 0.;
+            double sum[NPRIM] = {0.}, sum_x[NPRIM] = {0.};
+            // For all neighboring cells...
+            for (int n = -1; n <= 1; n++) {
+                for (int m = -1; m <= 1; m++) {
+                    for (int l = -1; l <= 1; l++) {
+                        int ii = i + l, jj = j + m, kk = k + n;
+                        // If we haven't overstepped array bounds...
+                        if (KDomain::inside(kk, jj, ii, b)) {
+                            // Weight by distance
+                            double w = 1./(m::abs(l) + m::abs(m) + m::abs(n) + 1);
+
+                            // Count only the good cells (not failed AND not corner), if we can
+                            if (!failed(pflag(kk, jj, ii))) {
+                                // Weight by distance.  Note interpolated "fixed" cells stay flagged
+                                wsum += w;
+                                PRIMLOOP sum[p] += w * P(p, kk, jj, ii);
                             }
+                            // Just in case, keep a sum of even the bad ones
+                            wsum_x += w;
+                            PRIMLOOP sum_x[p] += w * P(p, kk, jj, ii);
                         }
                     }
                 }
+            }
 
-                if(wsum < 1.e-10) {
-                    // TODO probably should crash here.
+            if(wsum < 1.e-10) {
+                // TODO probably should crash here.
 #ifndef KOKKOS_ENABLE_SYCL
-                    if (flag_verbose >= 3)
-                        printf("No neighbors were available at %d %d %d!\n", i, j, k);
+                if (flag_verbose >= 3)
+                    printf("No neighbors were available at %d %d %d!\n", i, j, k);
 #endif
-                    // TODO is there a situation in which this shadow is useful, or do we ditch it?
-                    PRIMLOOP P(p, k, j, i) = sum_x[p]/wsum_x;
-                } else {
-                    PRIMLOOP P(p, k, j, i) = sum[p]/wsum;
-                }
+                // TODO is there a situation in which this shadow is useful, or do we ditch it?
+                PRIMLOOP P(p, k, j, i) = sum_x[p]/wsum_x;
+            } else {
+                PRIMLOOP P(p, k, j, i) = sum[p]/wsum;
             }
         }
     );
@@ -138,17 +167,18 @@ TaskStatus Inverter::FixUtoP(MeshBlockData<Real> *rc)
         // Get floor flag
         GridScalar fflag = rc->Get("fflag").data;
 
-        pmb->par_for("fix_U_to_P_floors", b.ks, b.ke, b.js, b.je, b.is, b.ie,
-            KOKKOS_LAMBDA (const int &k, const int &j, const int &i) {
-                if (failed(pflag(k, j, i))) {
-                    // Make sure all fixed values still abide by floors (floors keep lockstep)
-                    // TODO Full floors instead of just geo?
-                    Floors::apply_geo_floors(G, P, m_p, gam, k, j, i, floors);
-
-                    // Make sure to keep lockstep
-                    // This will only be run for GRMHD, so we can call its p_to_u
-                    GRMHD::p_to_u(G, P, m_p, gam, k, j, i, U, m_u);
-                }
+        pmb->par_for("fix_U_to_P_floors", 0, nfailed-1,
+            KOKKOS_LAMBDA (const int &f) {
+                const int k = b.ks + failed_zones(f) / (nj*ni);
+                const int j = b.js + (failed_zones(f) / ni) % nj;
+                const int i = b.is + failed_zones(f) % ni;
+                // Make sure all fixed values still abide by floors (floors keep lockstep)
+                // TODO Full floors instead of just geo?
+                Floors::apply_geo_floors(G, P, m_p, gam, k, j, i, floors);
+
+                // Make sure to keep lockstep
+                // This will only be run for GRMHD, so we can call its p_to_u
+                GRMHD::p_to_u(G, P, m_p, gam, k, j, i, U, m_u);
             }
         );
     }
@@ -0,0 +1,186 @@
+/* 
+ *  File: fused_utop.cpp
+ *  
+ *  BSD 3-Clause License
+ *  
+ *  Copyright (c) 2020, AFD Group at UIUC
+ *  All rights reserved.
+ *  
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  
+ *  1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *  
+ *  2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *  
+ *  3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *  
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *  FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *  DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *  SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *  OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "inverter.hpp"
+
+#include "b_ct.hpp"
+#include "domain.hpp"
+#include "floors.hpp"
+#include "floors_functions.hpp"
+#include "kharma_package.hpp"
+
+bool Inverter::CanFuseUtoPFloors(Packages_t& packages)
+{
+    if (!packages.AllPackages().count("Inverter") ||
+        packages.Get("Inverter")->Param<Type>("inverter_type") == Type::none)
+        return false;
+
+    // Any other package's UtoP or floors would have to run between ours, so we can't fuse around them
+    auto kpackages = packages.AllPackagesOfType<KHARMAPackage>();
+    for (auto kpackage : kpackages) {
+        const std::string& name = kpackage.first;
+        if (kpackage.second->BlockUtoP != nullptr &&
+            name != "Inverter" && name != "B_CT" && name != "B_FluxCT" && name != "B_Cleanup")
+            return false;
+        if (kpackage.second->BlockApplyFloors != nullptr && name != "Floors")
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Fused equivalent of Packages::MeshUtoP followed by Packages::MeshApplyFloors, in one kernel over
+ * the whole MeshData.  Counts the failed zones in each block's physical range into n_failed,
+ * so that fixups can skip blocks without any failures.
+ */
+template<Inverter::Type inverter>
+inline void MeshPerformInversionFloors(MeshData<Real> *md, ParArray1D<int> n_failed)
+{
+    auto pmesh = md->GetMeshPointer();
+    auto pmb0 = md->GetBlockData(0)->GetBlockPointer();
+    auto& packages = pmesh->packages;
+    const int nblocks = md->NumBlocks();
+
+    // Face-centered B must be averaged to centers first, which has a stencil.
+    // Keep this as its own pass
+    if (packages.AllPackages().count("B_CT"))
+        B_CT::MeshUtoP(md, IndexDomain::entire, false);
+    // Otherwise, cell-centered B is recovered locally alongside the fluid
+    bool recover_b = false;
+    for (auto name : {"B_FluxCT", "B_Cleanup"})
+        if (packages.AllPackages().count(name) && packages.Get<KHARMAPackage>(name)->BlockUtoP != nullptr)
+            recover_b = true;
+
+    PackIndexMap prims_map, cons_map;
+    auto U = md->PackVariables(std::vector<MetadataFlag>{Metadata::Conserved, Metadata::Cell}, cons_map);
+    auto P = md->PackVariables(std::vector<MetadataFlag>{Metadata::GetUserFlag("Primitive"), Metadata::Cell}, prims_map);
+    const VarMap m_u(cons_map, true), m_p(prims_map, false);
+    auto pflag = md->PackVariables(std::vector<std::string>{"pflag"});
+    auto seed = md->PackVariables(std::vector<std::string>{"utop_seed"});
+    const bool use_seed = seed.GetDim(4) > 0;
+
+    if (U.GetDim(4) == 0 || pflag.GetDim(4) == 0)
+        return;
+
+    const bool do_floors = packages.AllPackages().count("Floors");
+    Floors::Prescription floors;
+    if (do_floors)
+        floors = Floors::Prescription(packages.Get("Floors")->AllParams());
+    // Just for the type, if we're not applying floors
+    auto fflag = do_floors ? md->PackVariables(std::vector<std::string>{"fflag"}) : pflag;
+
+    const Real gam = packages.Get("GRMHD")->Param<Real>("gamma");
+    const EMHD::EMHD_parameters& emhd_params = EMHD::GetEMHDParameters(packages);
+
+    // Inversion covers only the physical zones of each block, see BlockPerformInversion
+    ParArray1D<IndexRange3> phys("physical_ranges", nblocks);
+    auto phys_h = phys.GetHostMirror();
+    for (int b=0; b < nblocks; ++b)
+        phys_h(b) = KDomain::GetPhysicalRange(md->GetBlockData(b).get());
+    phys.DeepCopy(phys_h);
+
+    const IndexRange3 bi = KDomain::GetRange(md, IndexDomain::interior);
+
+    // Floors are applied over the entire domain, as in Packages::MeshApplyFloors
+    const IndexRange ib = md->GetBoundsI(IndexDomain::entire);
+    const IndexRange jb = md->GetBoundsJ(IndexDomain::entire);
+    const IndexRange kb = md->GetBoundsK(IndexDomain::entire);
+
+    pmb0->par_for("fused_UtoP_floors", 0, nblocks-1, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+        KOKKOS_LAMBDA (const int& b, const int &k, const int &j, const int &i) {
+            const auto& G = U.GetCoords(b);
+            if (recover_b) {
+                VLOOP P(b, m_p.B1 + v, k, j, i) = U(b, m_u.B1 + v, k, j, i) / G.gdet(Loci::center, j, i);
+            }
+
+            const bool inside = KDomain::inside(k, j, i, phys(b));
+            if (inside) {
+                // See BlockPerformInversion re: seeds
+                const bool seeded = use_seed && !KDomain::inside(k, j, i, bi);
+                pflag(b, 0, k, j, i) = static_cast<double>(Inverter::u_to_p<inverter>(G, U(b), m_u, gam, k, j, i, P(b), m_p, Loci::center,
+                                                                                        seeded, seeded ? seed(b, 0, k, j, i) : 0.));
+            }
+
+            // See Floors::ApplyGRMHDFloors for the logic here
+            if (do_floors && ((int) pflag(b, 0, k, j, i)) >= (int) Inverter::Status::success) {
+                const int comboflag = Floors::apply_floors(G, P(b), m_p, gam, emhd_params, k, j, i, floors, U(b), m_u);
+                int addflag = (comboflag / FFlag::MINIMUM) * FFlag::MINIMUM;
+                if (comboflag % FFlag::MINIMUM) {
+                    pflag(b, 0, k, j, i) = comboflag % FFlag::MINIMUM;
+                }
+                if (((int) pflag(b, 0, k, j, i)) >= (int) Inverter::Status::success) {
+                    addflag |= Floors::apply_ceilings(G, P(b), m_p, gam, k, j, i, floors, U(b), m_u);
+                }
+                fflag(b, 0, k, j, i) = addflag;
+            }
+
+            // Mark the block for fixing
+            if (inside && failed(pflag(b, 0, k, j, i))) {
+                Kokkos::atomic_add(&n_failed(b), 1);
+            }
+        }
+    );
+}
+
+TaskStatus Inverter::MeshUtoPFloorsFix(MeshData<Real> *md)
+{
+    auto& packages = md->GetMeshPointer()->packages;
+    if (!CanFuseUtoPFloors(packages)) {
+        Packages::MeshUtoP(md, IndexDomain::entire, false);
+        Packages::MeshApplyFloors(md, IndexDomain::entire);
+        return MeshFixUtoP(md);
+    }
+
+    Flag("MeshUtoPFloorsFix");
+    const int nblocks = md->NumBlocks();
+    ParArray1D<int> n_failed("n_failed", nblocks);
+
+    switch(packages.Get("Inverter")->Param<Type>("inverter_type")) {
+    case Type::onedw:
+        MeshPerformInversionFloors<Type::onedw>(md, n_failed);
+        break;
+    case Type::none:
+        break;
+    }
+
+    // Fixups need all neighbors inverted & floored, so they wait for the full pass above.
+    // Only blocks with failures need them at all
+    auto n_failed_h = n_failed.GetHostMirrorAndCopy();
+    for (int b=0; b < nblocks; ++b)
+        if (n_failed_h(b) > 0)
+            FixUtoP(md->GetBlockData(b).get());
+
+    EndFlag();
+    return TaskStatus::complete;
+}
@@ -77,6 +77,10 @@ KOKKOS_INLINE_FUNCTION bool failed(T status_flag)
  * 
  * On error, will not write replacement values, leaving the previous step's values in place
  * These are fixed later, in FixUtoP
+ *
+ * If 'use_seed' is set, iteration instead starts from the given 'seed' value, as computed by
+ * the inverter's 'utop_seed' function from the primitive variables.  This allows seeding
+ * the solve in ghost zones without synchronizing the primitive variables, see inverter.hpp
  * 
  * This is the function template: implementations are filled in in their own headers.
  * Be VERY CAREFUL to define any specializations by including those headers,
@@ -86,5 +90,5 @@ template<Type inverter>
 KOKKOS_INLINE_FUNCTION Status u_to_p(const GRCoordinates &G, const VariablePack<Real>& U, const VarMap& m_u,
                                               const Real& gam, const int& k, const int& j, const int& i,
                                               const VariablePack<Real>& P, const VarMap& m_p,
-                                              const Loci loc);
+                                              const Loci loc, const bool use_seed=false, const Real seed=0.);
 } // namespace Inverter
@@ -75,6 +75,19 @@ std::shared_ptr<KHARMAPackage> Inverter::Initialize(ParameterInput *pin, std::sh
     }
     pkg->AddField("pflag", m);
 
+    // Optionally, seed inversions in MPI ghost zones from one synchronized field holding the inverter's
+    // initial guess, rather than synchronizing the fluid primitive variables alongside the conserved ones.
+    // This cuts the fluid's ghost exchange nearly in half.  See MeshFillSeed below & kharma_step.cpp
+    bool compact_seed = pin->GetOrAddBoolean("inverter", "compact_seed", false);
+    if (compact_seed && sync_prims) {
+        throw std::invalid_argument("Compact inverter seeds are only used when synchronizing conserved variables!");
+    }
+    params.Add("compact_seed", compact_seed);
+    if (compact_seed) {
+        Metadata m_seed = Metadata({Metadata::Real, Metadata::Cell, Metadata::Derived, Metadata::OneCopy, Metadata::FillGhost});
+        pkg->AddField("utop_seed", m_seed);
+    }
+
     // We exist basically to do this
     pkg->BlockUtoP = Inverter::BlockUtoP;
     pkg->BoundaryUtoP = Inverter::BlockUtoP;
@@ -89,7 +102,7 @@ std::shared_ptr<KHARMAPackage> Inverter::Initialize(ParameterInput *pin, std::sh
  * This is called with the correct template argument from BlockUtoP
  */
 template<Inverter::Type inverter>
-inline void BlockPerformInversion(MeshBlockData<Real> *rc, IndexDomain domain, bool coarse)
+inline void BlockPerformInversion(MeshBlockData<Real> *rc, IndexDomain domain, bool coarse, bool skip_interior=false)
 {
     auto pmb = rc->GetBlockPointer();
     const auto& G = pmb->coords;
@@ -100,10 +113,16 @@ inline void BlockPerformInversion(MeshBlockData<Real> *rc, IndexDomain domain, b
     const VarMap m_u(cons_map, true), m_p(prims_map, false);
 
     auto pflag = rc->PackVariables(std::vector<std::string>{"pflag"});
+    auto seed = rc->PackVariables(std::vector<std::string>{"utop_seed"});
 
     if (U.GetDim(4) == 0 || pflag.GetDim(4) == 0)
         return;
 
+    // If we sync'd seeds rather than primitives, use them in ghost zones only:
+    // interior zones compute the same value from their primitive variables
+    const bool use_seed = seed.GetDim(4) > 0;
+    const IndexRange3 bi = KDomain::GetRange(rc, IndexDomain::interior, coarse);
+
     const Real gam = pmb->packages.Get("GRMHD")->Param<Real>("gamma");
 
     const Real err_tol = pmb->packages.Get("Inverter")->Param<Real>("err_tol");
@@ -113,14 +132,17 @@ inline void BlockPerformInversion(MeshBlockData<Real> *rc, IndexDomain domain, b
     // Get the primitives from our conserved versions
     // Notice we recover variables for only the physical (interior or MPI-boundary)
     // zones!  These are the only ones which are filled at our point in the step
+    // If asked, we recover just the interior, or just the MPI-boundary ghost zones
     auto bounds = coarse ? pmb->c_cellbounds : pmb->cellbounds;
-    const IndexRange3 b = KDomain::GetPhysicalRange(rc);
+    const IndexRange3 b = (domain == IndexDomain::interior) ? bi : KDomain::GetPhysicalRange(rc);
 
     pmb->par_for("U_to_P", b.ks, b.ke, b.js, b.je, b.is, b.ie,
         KOKKOS_LAMBDA (const int &k, const int &j, const int &i) {
-            if (KDomain::inside(k, j, i, b)) {
+            if (KDomain::inside(k, j, i, b) && !(skip_interior && KDomain::inside(k, j, i, bi))) {
                 // Run over all interior zones and any initialized ghosts
-                pflag(0, k, j, i) = static_cast<double>(Inverter::u_to_p<inverter>(G, U, m_u, gam, k, j, i, P, m_p, Loci::center));
+                const bool seeded = use_seed && !KDomain::inside(k, j, i, bi);
+                pflag(0, k, j, i) = static_cast<double>(Inverter::u_to_p<inverter>(G, U, m_u, gam, k, j, i, P, m_p, Loci::center,
+                                                                                    seeded, seeded ? seed(0, k, j, i) : 0.));
             }
         }
     );
@@ -140,6 +162,46 @@ void Inverter::BlockUtoP(MeshBlockData<Real> *rc, IndexDomain domain, bool coars
     //Reductions::StartFlagReduce(md, "pflag", Inverter::status_names, IndexDomain::interior, false, 1);
 }
 
+void Inverter::BlockUtoPGhosts(MeshBlockData<Real> *rc, bool coarse)
+{
+    auto& type = rc->GetBlockPointer()->packages.Get("Inverter")->Param<Type>("inverter_type");
+    switch(type) {
+    case Type::onedw:
+        BlockPerformInversion<Type::onedw>(rc, IndexDomain::entire, coarse, true);
+        break;
+    case Type::none:
+        break;
+    }
+}
+
+TaskStatus Inverter::MeshFillSeed(MeshData<Real> *md)
+{
+    auto seed = md->PackVariables(std::vector<std::string>{"utop_seed"});
+    if (seed.GetDim(4) == 0)
+        return TaskStatus::complete;
+
+    Flag("MeshFillSeed");
+    auto pmb0 = md->GetBlockData(0)->GetBlockPointer();
+
+    PackIndexMap prims_map;
+    auto P = md->PackVariables(std::vector<MetadataFlag>{Metadata::GetUserFlag("Primitive"), Metadata::Cell}, prims_map);
+    const VarMap m_p(prims_map, false);
+
+    const Real gam = pmb0->packages.Get("GRMHD")->Param<Real>("gamma");
+
+    const IndexRange3 b = KDomain::GetRange(md, IndexDomain::interior);
+    const IndexRange block = IndexRange{0, seed.GetDim(5) - 1};
+    pmb0->par_for("fill_utop_seed", block.s, block.e, b.ks, b.ke, b.js, b.je, b.is, b.ie,
+        KOKKOS_LAMBDA (const int& bl, const int &k, const int &j, const int &i) {
+            const auto& G = P.GetCoords(bl);
+            seed(bl, 0, k, j, i) = Inverter::utop_seed(G, P(bl), m_p, gam, k, j, i, Loci::center);
+        }
+    );
+
+    EndFlag();
+    return TaskStatus::complete;
+}
+
 TaskStatus Inverter::PostStepDiagnostics(const SimTime& tm, MeshData<Real> *md)
 {
     auto pmesh = md->GetMeshPointer();
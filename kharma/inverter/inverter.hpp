@@ -59,11 +59,24 @@ std::shared_ptr<KHARMAPackage> Initialize(ParameterInput *pin, std::shared_ptr<P
  * This just computes P, and only for the GRHD fluid varaibles rho, u, uvec.
  *
  * Defaults to entire domain, as the KHARMA algorithm relies on applying UtoP over ghost zones.
+ * Any domain other than IndexDomain::interior covers all physical zones, i.e. interior & MPI ghosts.
  * 
  * input: U, whatever form
  * output: U and P match down to inversion errors
  */
 void BlockUtoP(MeshBlockData<Real> *rc, IndexDomain domain, bool coarse);
+/**
+ * As BlockUtoP, but only over the MPI-boundary ghost zones, for when the interior was already
+ * inverted (with IndexDomain::interior) while the boundaries were being exchanged.
+ */
+void BlockUtoPGhosts(MeshBlockData<Real> *rc, bool coarse=false);
+
+/**
+ * Fill the 'utop_seed' field with the inverter's initial guess for each interior zone, computed from
+ * the current primitive variables.  When the "inverter/compact_seed" option is enabled, this field
+ * is synchronized in place of the fluid primitives, and seeds the inversion in MPI ghost zones.
+ */
+TaskStatus MeshFillSeed(MeshData<Real> *md);
 
 /**
  * Smooth over inversion failures, usually by averaging values of the primitive variables from each neighboring zone
@@ -80,6 +93,21 @@ inline TaskStatus MeshFixUtoP(MeshData<Real> *md) {
     return TaskStatus::complete;
 }
 
+/**
+ * Invert, apply floors, and fix inversion failures over a whole MeshData, equivalent to
+ * Packages::MeshUtoP, Packages::MeshApplyFloors, then MeshFixUtoP.
+ * Inversion, B field recovery & floors run in one kernel, which also counts failures per block,
+ * so that only blocks with failed zones are fixed.
+ * Falls back to the separate calls if any loaded package defines its own UtoP or floors.
+ *
+ * LOCKSTEP: this function expects and should preserve P<->U
+ */
+TaskStatus MeshUtoPFloorsFix(MeshData<Real> *md);
+/**
+ * Whether the fused pass above supports the current set of packages
+ */
+bool CanFuseUtoPFloors(Packages_t& packages);
+
 /**
  * Print details of any inversion failures or fixed zones
  */
@@ -91,6 +91,20 @@ KOKKOS_INLINE_FUNCTION Real err_eqn(const Real& gam, const Real& Bsq, const Real
 
 }
 
+/**
+ * Initial guess for the 1D_W inverter, W' = (rho + u + p) * gamma^2 - rho * gamma, from the primitive variables.
+ * Returns -1 if the primitive velocity is invalid.
+ */
+KOKKOS_INLINE_FUNCTION Real utop_seed(const GRCoordinates &G, const VariablePack<Real>& P, const VarMap& m_p,
+                                      const Real& gam, const int& k, const int& j, const int& i, const Loci loc)
+{
+    const Real gamma = GRMHD::lorentz_calc(G, P, m_p, k, j, i, loc);
+    if (gamma < 1) return -1.;
+    const Real rho = P(m_p.RHO, k, j, i), u = P(m_p.UU, k, j, i);
+
+    return (rho + u + (gam - 1) * u) * gamma * gamma - rho * gamma;
+}
+
 /**
  * 1D_W inverter from Ressler et al. 2006.
  */
@@ -98,7 +112,7 @@ template <>
 KOKKOS_INLINE_FUNCTION Status u_to_p<Type::onedw>(const GRCoordinates &G, const VariablePack<Real>& U, const VarMap& m_u,
                                               const Real& gam, const int& k, const int& j, const int& i,
                                               const VariablePack<Real>& P, const VarMap& m_p,
-                                              const Loci loc)
+                                              const Loci loc, const bool use_seed, const Real seed)
 {
     // if (i == 10 && j == 11)
     //     printf("CONS: %g %g %g %g %g %g %g %g", U(m_u.RHO, k, j, i), U(m_u.UU, k, j, i), U(m_u.U1, k, j, i), U(m_u.U2, k, j, i),
@@ -151,16 +165,20 @@ KOKKOS_INLINE_FUNCTION Status u_to_p<Type::onedw>(const GRCoordinates &G, const
     // Accumulator for errors in err_eqn
     Status eflag = Status::success;
 
-    // Initial guess from primitives:
-    Real Wp, err;
-    {
+    // Initial guess from primitives, or a seed computed from them
+    Real Wp;
+    if (use_seed) {
+        // utop_seed marks an invalid velocity with a negative seed
+        Wp = seed;
+        if (Wp < 0) return Status::bad_ut;
+    } else {
         const Real gamma = GRMHD::lorentz_calc(G, P, m_p, k, j, i, loc);
         if (gamma < 1) return Status::bad_ut;
         const Real rho = P(m_p.RHO, k, j, i), u = P(m_p.UU, k, j, i);
 
         Wp = (rho + u + (gam - 1) * u) * gamma * gamma - rho * gamma;
-        err = err_eqn(gam, Bsq, D, Ep, QdB, Qtsq, Wp, eflag);
     }
+    Real err = err_eqn(gam, Bsq, D, Ep, QdB, Qtsq, Wp, eflag);
 
     Real dW;
     {
@@ -50,6 +50,9 @@
 #include "kharma_driver.hpp"
 #include "electrons.hpp"
 #include "implicit.hpp"
+#include "multirate.hpp"
+#include "multizone.hpp"
+#include "block_cost.hpp"
 #include "floors.hpp"
 #include "grmhd.hpp"
 #include "reductions.hpp"
@@ -137,6 +140,12 @@ void KHARMA::PostStepWork(Mesh *pmesh, ParameterInput *pin, const SimTime &tm)
     auto& globals = pmesh->packages.Get("Globals")->AllParams();
     globals.Update<double>("dt_last", tm.dt);
     globals.Update<double>("time", tm.time);
+
+    // Blocks may have moved or been refined since last step, so drop
+    // any shared geometry caches that no block on this rank still uses
+    std::vector<GRCoordinates> coords_in_use;
+    for (auto &pmb : pmesh->block_list) coords_in_use.push_back(pmb->coords);
+    GRCoordinates::PruneSharedGeometry(coords_in_use);
 }
 
 void KHARMA::FixParameters(ParameterInput *pin)
@@ -385,6 +394,19 @@ Packages_t KHARMA::ProcessPackages(std::unique_ptr<ParameterInput> &pin)
         KHARMA::AddPackage(packages, Implicit::Initialize, pin.get());
     }
 
+    // Multi-rate stepping keeps registers of every flux, so it must come after anything with fluxes
+    if (pin->GetOrAddBoolean("driver", "multirate", false)) {
+        KHARMA::AddPackage(packages, Multirate::Initialize, pin.get());
+    }
+    // In-process multizone runs, stepping only one annulus of the domain at a time
+    if (pin->GetOrAddBoolean("multizone", "on", false)) {
+        KHARMA::AddPackage(packages, Multizone::Initialize, pin.get());
+    }
+    // Load balancing by the estimated cost of each block, rather than the number of blocks
+    if (pin->GetOrAddBoolean("block_cost", "on", false)) {
+        KHARMA::AddPackage(packages, BlockCost::Initialize, pin.get());
+    }
+
 #if DEBUG
     // Carry the ParameterInput with us, for generating outputs whenever we want
     packages->Get("Globals")->AllParams().Add("pin", pin.get());
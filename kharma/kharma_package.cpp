@@ -33,6 +33,7 @@
  */
 #include "kharma_package.hpp"
 
+#include "inverter.hpp"
 #include "types.hpp"
 
 // TODO clearly this needs a better concept of ordering.
@@ -55,9 +56,10 @@ TaskStatus Packages::FixFlux(MeshData<Real> *md)
     return TaskStatus::complete;
 }
 
-TaskStatus Packages::BlockUtoP(MeshBlockData<Real> *rc, IndexDomain domain, bool coarse)
+// If interior_inverted, the GRMHD inversion was already run over the interior zones,
+// and is only run over the MPI ghost zones here.  Other packages' UtoP is cheap, so it just re-runs
+static void BlockUtoPImpl(MeshBlockData<Real> *rc, IndexDomain domain, bool coarse, bool interior_inverted)
 {
-    Flag("BlockUtoP");
     // Apply UtoP from B_CT first, as this fills cons.B at cell centers
     auto pmb = rc->GetBlockPointer();
     auto kpackages = rc->GetBlockPointer()->packages.AllPackagesOfType<KHARMAPackage>();
@@ -74,7 +76,11 @@ TaskStatus Packages::BlockUtoP(MeshBlockData<Real> *rc, IndexDomain domain, bool
         KHARMAPackage *pkpackage = pmb->packages.Get<KHARMAPackage>("Inverter");
         if (pkpackage->BlockUtoP != nullptr) {
             Flag("BlockUtoP_Inverter");
-            pkpackage->BlockUtoP(rc, domain, coarse);
+            if (interior_inverted) {
+                Inverter::BlockUtoPGhosts(rc, coarse);
+            } else {
+                pkpackage->BlockUtoP(rc, domain, coarse);
+            }
             EndFlag();
         }
     }
@@ -85,6 +91,12 @@ TaskStatus Packages::BlockUtoP(MeshBlockData<Real> *rc, IndexDomain domain, bool
             EndFlag();
         }
     }
+}
+
+TaskStatus Packages::BlockUtoP(MeshBlockData<Real> *rc, IndexDomain domain, bool coarse)
+{
+    Flag("BlockUtoP");
+    BlockUtoPImpl(rc, domain, coarse, false);
     EndFlag();
     return TaskStatus::complete;
 }
@@ -97,6 +109,14 @@ TaskStatus Packages::MeshUtoP(MeshData<Real> *md, IndexDomain domain, bool coars
     EndFlag();
     return TaskStatus::complete;
 }
+TaskStatus Packages::MeshUtoPGhosts(MeshData<Real> *md)
+{
+    Flag("MeshUtoPGhosts");
+    for (int i=0; i < md->NumBlocks(); ++i)
+        BlockUtoPImpl(md->GetBlockData(i).get(), IndexDomain::entire, false, true);
+    EndFlag();
+    return TaskStatus::complete;
+}
 
 TaskStatus Packages::BoundaryUtoP(MeshBlockData<Real> *rc, IndexDomain domain, bool coarse)
 {
@@ -127,6 +127,11 @@ TaskStatus FixFlux(MeshData<Real> *md);
  */
 TaskStatus BlockUtoP(MeshBlockData<Real> *mbd, IndexDomain domain, bool coarse=false);
 TaskStatus MeshUtoP(MeshData<Real> *md, IndexDomain domain, bool coarse=false);
+/**
+ * As MeshUtoP over the entire domain, after the interior was already inverted with
+ * MeshUtoP(md, IndexDomain::interior): the GRMHD inversion is re-run only in MPI ghost zones.
+ */
+TaskStatus MeshUtoPGhosts(MeshData<Real> *md);
 
 /**
  * U to P specifically for boundaries (domain and MPI).
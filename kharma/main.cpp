@@ -246,6 +246,9 @@ int main(int argc, char *argv[])
         EndFlag();
     }
 
+    // Release the registry's references to geometry before Kokkos is finalized
+    GRCoordinates::ClearSharedGeometry();
+
     // Parthenon cleanup includes Kokkos, MPI
     Flag("ParthenonFinalize");
     pman.ParthenonFinalize();
@@ -63,13 +63,11 @@ inline T MPIReduce_once(T f, MPI_Op O)
 }
 
 // Shorter names for the reductions we use here
-Real MaxBsq(MeshData<Real> *md)
+// Both maxima are taken in the same sweep
+std::vector<Real> MaxBsqPressure(MeshData<Real> *md)
 {
-    return Reductions::DomainReduction<Reductions::Var::bsq, Real>(md, UserHistoryOperation::max);
-}
-Real MaxPressure(MeshData<Real> *md)
-{
-    return Reductions::DomainReduction<Reductions::Var::gas_pressure, Real>(md, UserHistoryOperation::max);
+    return Reductions::DomainReductions<Real>(md, {Reductions::Var::bsq, Reductions::Var::gas_pressure},
+                                              {UserHistoryOperation::max, UserHistoryOperation::max});
 }
 Real MinBeta(MeshData<Real> *md)
 {
@@ -424,8 +422,9 @@ TaskStatus NormalizeBField(MeshData<Real> *md, ParameterInput *pin)
     // Calculate current beta_min value
     Real bsq_max, p_max, beta_min;
     if (beta_calc_legacy) {
-        bsq_max = MPIReduce_once(MaxBsq(md), MPI_MAX);
-        p_max = MPIReduce_once(MaxPressure(md), MPI_MAX);
+        const auto maxes = MPIReduce_once(MaxBsqPressure(md), MPI_MAX);
+        bsq_max = maxes[0];
+        p_max = maxes[1];
         beta_min = p_max / (0.5 * bsq_max);
     } else {
         beta_min = MPIReduce_once(MinBeta(md), MPI_MIN);
@@ -452,8 +451,9 @@ TaskStatus NormalizeBField(MeshData<Real> *md, ParameterInput *pin)
     if (verbose > 0) {
         Real bsq_max, p_max, beta_min;
         if (beta_calc_legacy) {
-            bsq_max = MPIReduce_once(MaxBsq(md), MPI_MAX);
-            p_max = MPIReduce_once(MaxPressure(md), MPI_MAX);
+            const auto maxes = MPIReduce_once(MaxBsqPressure(md), MPI_MAX);
+            bsq_max = maxes[0];
+            p_max = maxes[1];
             beta_min = p_max / (0.5 * bsq_max);
         } else {
             beta_min = MPIReduce_once(MinBeta(md), MPI_MIN);
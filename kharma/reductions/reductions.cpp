@@ -111,17 +111,17 @@ std::vector<int> Reductions::CountFlags(MeshData<Real> *md, std::string field_na
     IndexRange kb = md->GetBoundsK(domain);
     IndexRange block = IndexRange{0, flag.GetDim(5) - 1};
 
-    // Man, moving arrays is clunky.  Oh well.
+    // Flag values are small, so we can pass them to the device by value rather
+    // than allocating & copying a list each call
     const int n_of_flags = flag_values.size();
-    ParArray1D<int> flag_val_list("flag_values", MAX_NFLAGS);
-    auto flag_val_list_h = flag_val_list.GetHostMirror();
+    if (n_of_flags + 1 > MAX_NFLAGS)
+        throw std::invalid_argument("Too many flag values to count! Increase MAX_NFLAGS.");
+    Reductions::array_type<int, MAX_NFLAGS> flag_val_list;
     int f=1;
     for (auto &flag : flag_values) {
-        flag_val_list_h[f] = flag.first;
+        flag_val_list.my_array[f] = flag.first;
         f++;
     }
-    flag_val_list.DeepCopy(flag_val_list_h);
-    Kokkos::fence();
 
     // Count all nonzero (technically, >0) values,
     // and all values which match each flag.
@@ -132,12 +132,14 @@ std::vector<int> Reductions::CountFlags(MeshData<Real> *md, std::string field_na
         KOKKOS_LAMBDA (const int &b, const int &k, const int &j, const int &i, 
                        Reductions::array_type<int, MAX_NFLAGS> &local_result) {
             const int flag_int = static_cast<int>(flag(b, 0, k, j, i));
+            // Most zones are unflagged, so skip the comparisons
+            if (flag_int == 0) return;
             // First element is total count
             if (flag_int > 0) ++local_result.my_array[0];
             // The rest of the list is individual flags
-            for (int f=1; f < n_of_flags; f++)
-                if ((is_bitflag && flag_int & flag_val_list(f)) ||
-                    (!is_bitflag && flag_int == flag_val_list(f)))
+            for (int f=1; f <= n_of_flags; f++)
+                if ((is_bitflag && flag_int & flag_val_list.my_array[f]) ||
+                    (!is_bitflag && flag_int == flag_val_list.my_array[f]))
                     ++local_result.my_array[f];
         }
     , Reductions::ArraySum<int, HostExecSpace, MAX_NFLAGS>(flag_reducer));
@@ -73,6 +73,31 @@ T DomainReduction(MeshData<Real> *md, UserHistoryOperation op, int channel=-1) {
     return DomainReduction<var, T>(md, op, startx, stopx, channel);
 }
 
+// Maximum number of quantities which may be reduced together in one sweep
+#define MAX_NREDUCE 16
+
+/**
+ * Batched versions of the above: reduce each variable in 'vars' with the corresponding operation in 'ops',
+ * all in a single sweep over the mesh.  Four-vectors and T^1_mu are computed at most once per zone,
+ * and only if some requested variable needs them.
+ * Returns a vector of results in the order requested.
+ * Results are local to this rank.  If 'channel' is given, DomainReductions also starts a vector
+ * MPI reduction of the results, which requires all operations be the same.
+ */
+template<typename T>
+std::vector<T> EHReductions(MeshData<Real> *md, const std::vector<Var>& vars,
+                            const std::vector<UserHistoryOperation>& ops, int zone);
+template<typename T>
+std::vector<T> DomainReductions(MeshData<Real> *md, const std::vector<Var>& vars, const std::vector<UserHistoryOperation>& ops,
+                                const GReal startx[3], const GReal stopx[3], int channel=-1);
+template<typename T>
+std::vector<T> DomainReductions(MeshData<Real> *md, const std::vector<Var>& vars,
+                                const std::vector<UserHistoryOperation>& ops, int channel=-1) {
+    const GReal startx[3] = {std::numeric_limits<Real>::min(), std::numeric_limits<Real>::min(), std::numeric_limits<Real>::min()};
+    const GReal stopx[3] = {std::numeric_limits<Real>::max(), std::numeric_limits<Real>::max(), std::numeric_limits<Real>::max()};
+    return DomainReductions<T>(md, vars, ops, startx, stopx, channel);
+}
+
 /**
  * Start reductions with a value you have on hand
  */
@@ -302,5 +302,198 @@ T Reductions::DomainReduction(MeshData<Real> *md, UserHistoryOperation op, const
     return result;
 }
 
+// Batched reductions
+
+// Check arguments and pack the variable list & operations into arrays we can capture on device
+inline void PackBatchedReduction(const std::vector<Reductions::Var>& vars, const std::vector<UserHistoryOperation>& ops,
+                                 Reductions::array_type<int, MAX_NREDUCE>& var_list,
+                                 Reductions::array_type<int, MAX_NREDUCE>& op_list,
+                                 bool& any_4vecs, bool& any_tensor)
+{
+    if (vars.size() != ops.size())
+        throw std::invalid_argument("Batched reductions require one operation per variable!");
+    if (vars.size() > MAX_NREDUCE)
+        throw std::invalid_argument("Too many variables for one batched reduction! Increase MAX_NREDUCE.");
+    any_4vecs = false;
+    any_tensor = false;
+    for (int n=0; n < vars.size(); n++) {
+        var_list.my_array[n] = static_cast<int>(vars[n]);
+        op_list.my_array[n] = static_cast<int>(ops[n]);
+        any_4vecs = any_4vecs || Reductions::needs_4vecs(vars[n]);
+        any_tensor = any_tensor || Reductions::needs_tensor(vars[n]);
+    }
+    // Pad unused slots with sums, so they stay zero
+    for (int n=vars.size(); n < MAX_NREDUCE; n++) {
+        var_list.my_array[n] = 0;
+        op_list.my_array[n] = static_cast<int>(UserHistoryOperation::sum);
+    }
+}
+
+// Fill the local result with a zone's contribution to each variable, weighted by 'weight'
+// Note the reducer does the combining: here we just apply each operation once
+#define BATCHED_ZONE_CONTRIBUTION(weight) \
+    FourVectors D; \
+    Real T1[GR_DIM] = {0}; \
+    if (any_4vecs) GRMHD::calc_4vecs(G, P(b), m_p, k, j, i, Loci::center, D); \
+    if (any_tensor) Flux::calc_tensor(P(b), m_p, D, emhd_params, gam, k, j, i, X1DIR, T1); \
+    for (int n=0; n < nvars; n++) { \
+        const T val = reduction_var_batched(static_cast<Var>(var_list.my_array[n]), REDUCE_FUNCTION_CALL, D, T1) * (weight); \
+        if (op_list.my_array[n] == static_cast<int>(UserHistoryOperation::max)) { \
+            if (val > local_result.my_array[n]) local_result.my_array[n] = val; \
+        } else if (op_list.my_array[n] == static_cast<int>(UserHistoryOperation::min)) { \
+            if (val < local_result.my_array[n]) local_result.my_array[n] = val; \
+        } else { \
+            local_result.my_array[n] += val; \
+        } \
+    }
+
+// Combine results from different blocks on the host
+template<typename T>
+inline void CombineBatched(std::vector<T>& result, const Reductions::array_type<T, MAX_NREDUCE>& block_result,
+                           const std::vector<UserHistoryOperation>& ops)
+{
+    for (int n=0; n < result.size(); n++) {
+        switch(ops[n]) {
+        case UserHistoryOperation::sum:
+            result[n] += block_result.my_array[n];
+            break;
+        case UserHistoryOperation::max:
+            if (block_result.my_array[n] > result[n]) result[n] = block_result.my_array[n];
+            break;
+        case UserHistoryOperation::min:
+            if (block_result.my_array[n] < result[n]) result[n] = block_result.my_array[n];
+            break;
+        }
+    }
+}
+
+template<typename T>
+std::vector<T> Reductions::EHReductions(MeshData<Real> *md, const std::vector<Var>& vars,
+                                        const std::vector<UserHistoryOperation>& ops, int zone)
+{
+    Flag("EHReductions");
+    auto pmesh = md->GetMeshPointer();
+
+    const auto& pars = pmesh->packages.Get("GRMHD")->AllParams();
+    const Real gam = pars.Get<Real>("gamma");
+    const auto& emhd_params = EMHD::GetEMHDParameters(pmesh->packages);
+
+    array_type<int, MAX_NREDUCE> var_list, op_list;
+    bool any_4vecs, any_tensor;
+    PackBatchedReduction(vars, ops, var_list, op_list, any_4vecs, any_tensor);
+    const int nvars = vars.size();
+
+    PackIndexMap prims_map, cons_map;
+    const auto& P = md->PackVariables(std::vector<MetadataFlag>{Metadata::GetUserFlag("Primitive")}, prims_map);
+    const auto& U = md->PackVariablesAndFluxes(std::vector<MetadataFlag>{Metadata::Conserved}, cons_map);
+    const VarMap m_u(cons_map, true), m_p(prims_map, false);
+    const auto& cmax = md->PackVariables(std::vector<std::string>{"Flux.cmax"});
+    const auto& cmin = md->PackVariables(std::vector<std::string>{"Flux.cmin"});
+
+    auto pmb0 = md->GetBlockData(0)->GetBlockPointer();
+    IndexRange ib = pmb0->cellbounds.GetBoundsI(IndexDomain::interior);
+    IndexRange jb = pmb0->cellbounds.GetBoundsJ(IndexDomain::interior);
+    IndexRange kb = pmb0->cellbounds.GetBoundsK(IndexDomain::interior);
+
+    // Match the single-variable version, which starts all operations from zero
+    std::vector<T> result(nvars, 0);
+    int nb = pmesh->GetNumMeshBlocksThisRank();
+    for (int iblock=0; iblock < nb; iblock++) {
+        const auto &pmb = pmesh->block_list[iblock];
+        // Inner-edge blocks only for speed
+        if (pmb->boundary_flag[parthenon::BoundaryFace::inner_x1] == BoundaryFlag::user) {
+            const auto& G = pmb->coords;
+            array_type<T, MAX_NREDUCE> block_result;
+            pmb->par_reduce("accretion_batched", iblock, iblock, kb.s, kb.e, jb.s, jb.e, ib.s+zone, ib.s+zone,
+                KOKKOS_LAMBDA (const int &b, const int &k, const int &j, const int &i,
+                               array_type<T, MAX_NREDUCE> &local_result) {
+                    BATCHED_ZONE_CONTRIBUTION(G.Dxc<3>(k) * G.Dxc<2>(j))
+                }
+            , ArrayMultiOp<T, HostExecSpace, MAX_NREDUCE>(block_result, op_list));
+            CombineBatched<T>(result, block_result, ops);
+        }
+    }
+
+    EndFlag();
+    return result;
+}
+
+template<typename T>
+std::vector<T> Reductions::DomainReductions(MeshData<Real> *md, const std::vector<Var>& vars, const std::vector<UserHistoryOperation>& ops,
+                                            const GReal startx[3], const GReal stopx[3], int channel)
+{
+    Flag("DomainReductions");
+    auto pmesh = md->GetMeshPointer();
+
+    const auto& pars = pmesh->packages.Get("GRMHD")->AllParams();
+    const Real gam = pars.Get<Real>("gamma");
+    const auto& emhd_params = EMHD::GetEMHDParameters(pmesh->packages);
+
+    array_type<int, MAX_NREDUCE> var_list, op_list;
+    bool any_4vecs, any_tensor;
+    PackBatchedReduction(vars, ops, var_list, op_list, any_4vecs, any_tensor);
+    const int nvars = vars.size();
+
+    // A single MPI reduction can only apply one operation
+    MPI_Op mop = MPI_SUM;
+    if (channel >= 0 && nvars > 0) {
+        for (auto op : ops) if (op != ops[0])
+            throw std::invalid_argument("Batched reductions over MPI must use the same operation for all variables!");
+        mop = (ops[0] == UserHistoryOperation::max) ? MPI_MAX : ((ops[0] == UserHistoryOperation::min) ? MPI_MIN : MPI_SUM);
+    }
+
+    PackIndexMap prims_map, cons_map;
+    const auto& P = md->PackVariables(std::vector<MetadataFlag>{Metadata::GetUserFlag("Primitive")}, prims_map);
+    const auto& U = md->PackVariablesAndFluxes(std::vector<MetadataFlag>{Metadata::Conserved}, cons_map);
+    const VarMap m_u(cons_map, true), m_p(prims_map, false);
+    const auto& cmax = md->PackVariables(std::vector<std::string>{"Flux.cmax"});
+    const auto& cmin = md->PackVariables(std::vector<std::string>{"Flux.cmin"});
+
+    auto pmb0 = md->GetBlockData(0)->GetBlockPointer();
+    IndexRange ib = pmb0->cellbounds.GetBoundsI(IndexDomain::interior);
+    IndexRange jb = pmb0->cellbounds.GetBoundsJ(IndexDomain::interior);
+    IndexRange kb = pmb0->cellbounds.GetBoundsK(IndexDomain::interior);
+    IndexRange block = IndexRange{0, U.GetDim(5) - 1};
+
+    bool trivial_tmp[3] = {false, false, false};
+    VLOOP if(startx[v] == stopx[v]) {
+        trivial_tmp[v] = true;
+    }
+
+    const bool trivial1 = trivial_tmp[0];
+    const bool trivial2 = trivial_tmp[1];
+    const bool trivial3 = trivial_tmp[2];
+    const GReal startx1 = startx[0];
+    const GReal startx2 = startx[1];
+    const GReal startx3 = startx[2];
+    const GReal stopx1 = stopx[0];
+    const GReal stopx2 = stopx[1];
+    const GReal stopx3 = stopx[2];
+
+    array_type<T, MAX_NREDUCE> reduced;
+    pmb0->par_reduce("domain_batched", block.s, block.e, kb.s, kb.e, jb.s, jb.e, ib.s, ib.e,
+        KOKKOS_LAMBDA (const int &b, const int &k, const int &j, const int &i,
+                       array_type<T, MAX_NREDUCE> &local_result) {
+            const auto& G = U.GetCoords(b);
+            GReal x[4];
+            G.coord_embed(k, j, i, Loci::center, x);
+            if(INSIDE) {
+                BATCHED_ZONE_CONTRIBUTION((!trivial3) * G.Dxc<3>(k) * (!trivial2) * G.Dxc<2>(j) * (!trivial1) * G.Dxc<1>(i))
+            }
+        }
+    , ArrayMultiOp<T, HostExecSpace, MAX_NREDUCE>(reduced, op_list));
+
+    std::vector<T> result(reduced.my_array, reduced.my_array + nvars);
+
+    // Optionally start an MPI reducer w/given index, so the mesh-wide result is ready when we want it
+    if (channel >= 0) {
+        Start<std::vector<T>>(md, channel, result, mop);
+    }
+
+    EndFlag();
+    return result;
+}
+
+#undef BATCHED_ZONE_CONTRIBUTION
 #undef INSIDE
 #undef REDUCE_FUNCTION_CALL
@@ -113,4 +113,60 @@ struct ArraySum {
   KOKKOS_INLINE_FUNCTION
   bool references_scalar() const { return true; }
 };
+// Reducer for arrays in which each element carries its own operation,
+// so that sums, maxima & minima of several quantities can share one sweep.
+// Operations are the integer values of UserHistoryOperation
+template <class T, class Space, int N>
+struct ArrayMultiOp {
+ public:
+  // Required
+  typedef ArrayMultiOp reducer;
+  typedef array_type<T, N> value_type;
+  typedef Kokkos::View<value_type*, Space, Kokkos::MemoryUnmanaged>
+      result_view_type;
+
+ private:
+  value_type& value;
+  array_type<int, N> ops;
+
+ public:
+  KOKKOS_INLINE_FUNCTION
+  ArrayMultiOp(value_type& value_, const array_type<int, N>& ops_) : value(value_), ops(ops_) {}
+
+  // Required
+  KOKKOS_INLINE_FUNCTION
+  void join(value_type& dest, const value_type& src) const {
+    for (int i = 0; i < N; i++) {
+      if (ops.my_array[i] == static_cast<int>(parthenon::UserHistoryOperation::max)) {
+        if (src.my_array[i] > dest.my_array[i]) dest.my_array[i] = src.my_array[i];
+      } else if (ops.my_array[i] == static_cast<int>(parthenon::UserHistoryOperation::min)) {
+        if (src.my_array[i] < dest.my_array[i]) dest.my_array[i] = src.my_array[i];
+      } else {
+        dest.my_array[i] += src.my_array[i];
+      }
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void init(value_type& val) const {
+    for (int i = 0; i < N; i++) {
+      if (ops.my_array[i] == static_cast<int>(parthenon::UserHistoryOperation::max)) {
+        val.my_array[i] = Kokkos::reduction_identity<T>::max();
+      } else if (ops.my_array[i] == static_cast<int>(parthenon::UserHistoryOperation::min)) {
+        val.my_array[i] = Kokkos::reduction_identity<T>::min();
+      } else {
+        val.my_array[i] = Kokkos::reduction_identity<T>::sum();
+      }
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  value_type& reference() const { return value; }
+
+  KOKKOS_INLINE_FUNCTION
+  result_view_type view() const { return result_view_type(&value, 1); }
+
+  KOKKOS_INLINE_FUNCTION
+  bool references_scalar() const { return true; }
+};
 }
\ No newline at end of file
@@ -68,12 +68,39 @@ KOKKOS_INLINE_FUNCTION Real reduction_var<Var::phi>(REDUCE_FUNCTION_ARGS)
     return 0.5 * m::abs(U(m_u.B1, k, j, i)); // factor of gdet already in cons.B
 }
 
+// Quantities depending on the fluid four-vectors and/or the X1 row of the
+// stress-energy tensor are written in terms of precomputed values, so that
+// batched reductions can compute these once per zone & share them.
+// The single-variable versions below just compute what they need & call through.
+#define REDUCE_SHARED_ARGS REDUCE_FUNCTION_ARGS, const FourVectors& D, const Real T1[GR_DIM]
+template<Var T>
+KOKKOS_INLINE_FUNCTION Real reduction_var_shared(REDUCE_SHARED_ARGS);
+
+/**
+ * Whether computing a variable requires the fluid four-vectors, or additionally
+ * the stress-energy tensor T^1_mu
+ */
+KOKKOS_INLINE_FUNCTION bool needs_4vecs(const Var& var)
+{
+    return var == Var::bsq || var == Var::mag_pressure || var == Var::beta || var == Var::mdot || var == Var::edot ||
+           var == Var::ldot || var == Var::eht_lum || var == Var::jet_lum;
+}
+KOKKOS_INLINE_FUNCTION bool needs_tensor(const Var& var)
+{
+    return var == Var::edot || var == Var::ldot || var == Var::jet_lum;
+}
+
+template <>
+KOKKOS_INLINE_FUNCTION Real reduction_var_shared<Var::bsq>(REDUCE_SHARED_ARGS)
+{
+    return dot(D.bcon, D.bcov);
+}
 template <>
 KOKKOS_INLINE_FUNCTION Real reduction_var<Var::bsq>(REDUCE_FUNCTION_ARGS)
 {
     FourVectors Dtmp;
     GRMHD::calc_4vecs(G, P, m_p, k, j, i, Loci::center, Dtmp);
-    return dot(Dtmp.bcon, Dtmp.bcov);
+    return reduction_var_shared<Var::bsq>(G, P, m_p, U, m_u, cmax, cmin, emhd_params, gam, k, j, i, Dtmp, nullptr);
 }
 template <>
 KOKKOS_INLINE_FUNCTION Real reduction_var<Var::gas_pressure>(REDUCE_FUNCTION_ARGS)
@@ -81,16 +108,39 @@ KOKKOS_INLINE_FUNCTION Real reduction_var<Var::gas_pressure>(REDUCE_FUNCTION_ARG
     return (gam - 1) * P(m_p.UU, k, j, i);
 }
 template <>
+KOKKOS_INLINE_FUNCTION Real reduction_var_shared<Var::mag_pressure>(REDUCE_SHARED_ARGS)
+{
+    return 0.5 * dot(D.bcon, D.bcov);
+}
+template <>
+KOKKOS_INLINE_FUNCTION Real reduction_var<Var::mag_pressure>(REDUCE_FUNCTION_ARGS)
+{
+    FourVectors Dtmp;
+    GRMHD::calc_4vecs(G, P, m_p, k, j, i, Loci::center, Dtmp);
+    return reduction_var_shared<Var::mag_pressure>(G, P, m_p, U, m_u, cmax, cmin, emhd_params, gam, k, j, i, Dtmp, nullptr);
+}
+template <>
+KOKKOS_INLINE_FUNCTION Real reduction_var_shared<Var::beta>(REDUCE_SHARED_ARGS)
+{
+    return ((gam - 1) * P(m_p.UU, k, j, i))/(0.5*(dot(D.bcon, D.bcov) + SMALL));
+}
+template <>
 KOKKOS_INLINE_FUNCTION Real reduction_var<Var::beta>(REDUCE_FUNCTION_ARGS)
 {
     FourVectors Dtmp;
     GRMHD::calc_4vecs(G, P, m_p, k, j, i, Loci::center, Dtmp);
-    return ((gam - 1) * P(m_p.UU, k, j, i))/(0.5*(dot(Dtmp.bcon, Dtmp.bcov) + SMALL));
+    return reduction_var_shared<Var::beta>(G, P, m_p, U, m_u, cmax, cmin, emhd_params, gam, k, j, i, Dtmp, nullptr);
 }
 
 // Accretion rates: return a zone's contribution to the surface integral
 // forming each rate measurement.
 template <>
+KOKKOS_INLINE_FUNCTION Real reduction_var_shared<Var::mdot>(REDUCE_SHARED_ARGS)
+{
+    // \dot{M} == \int rho * u^1 * gdet * dx2 * dx3
+    return -P(m_p.RHO, k, j, i) * D.ucon[X1DIR] * G.gdet(Loci::center, j, i);
+}
+template <>
 KOKKOS_INLINE_FUNCTION Real reduction_var<Var::mdot>(REDUCE_FUNCTION_ARGS)
 {
     Real ucon[GR_DIM];
@@ -99,14 +149,25 @@ KOKKOS_INLINE_FUNCTION Real reduction_var<Var::mdot>(REDUCE_FUNCTION_ARGS)
     return -P(m_p.RHO, k, j, i) * ucon[X1DIR] * G.gdet(Loci::center, j, i);
 }
 template <>
+KOKKOS_INLINE_FUNCTION Real reduction_var_shared<Var::edot>(REDUCE_SHARED_ARGS)
+{
+    // \dot{E} == \int - T^1_0 * gdet * dx2 * dx3
+    return -T1[X0DIR] * G.gdet(Loci::center, j, i);
+}
+template <>
 KOKKOS_INLINE_FUNCTION Real reduction_var<Var::edot>(REDUCE_FUNCTION_ARGS)
 {
     FourVectors Dtmp;
     Real T1[GR_DIM];
     GRMHD::calc_4vecs(G, P, m_p, k, j, i, Loci::center, Dtmp);
     Flux::calc_tensor(P, m_p, Dtmp, emhd_params, gam, k, j, i, X1DIR, T1);
-    // \dot{E} == \int - T^1_0 * gdet * dx2 * dx3
-    return -T1[X0DIR] * G.gdet(Loci::center, j, i);
+    return reduction_var_shared<Var::edot>(G, P, m_p, U, m_u, cmax, cmin, emhd_params, gam, k, j, i, Dtmp, T1);
+}
+template <>
+KOKKOS_INLINE_FUNCTION Real reduction_var_shared<Var::ldot>(REDUCE_SHARED_ARGS)
+{
+    // \dot{L} == \int T^1_3 * gdet * dx2 * dx3
+    return T1[X3DIR] * G.gdet(Loci::center, j, i);
 }
 template <>
 KOKKOS_INLINE_FUNCTION Real reduction_var<Var::ldot>(REDUCE_FUNCTION_ARGS)
@@ -115,8 +176,7 @@ KOKKOS_INLINE_FUNCTION Real reduction_var<Var::ldot>(REDUCE_FUNCTION_ARGS)
     Real T1[GR_DIM];
     GRMHD::calc_4vecs(G, P, m_p, k, j, i, Loci::center, Dtmp);
     Flux::calc_tensor(P, m_p, Dtmp, emhd_params, gam, k, j, i, X1DIR, T1);
-    // \dot{L} == \int T^1_3 * gdet * dx2 * dx3
-    return T1[X3DIR] * G.gdet(Loci::center, j, i);
+    return reduction_var_shared<Var::ldot>(G, P, m_p, U, m_u, cmax, cmin, emhd_params, gam, k, j, i, Dtmp, T1);
 }
 
 // Then we can define the same with fluxes.
@@ -138,35 +198,45 @@ KOKKOS_INLINE_FUNCTION Real reduction_var<Var::ldot_flux>(REDUCE_FUNCTION_ARGS)
 
 // Luminosity proxy from (for example) Porth et al 2019.
 template <>
-KOKKOS_INLINE_FUNCTION Real reduction_var<Var::eht_lum>(REDUCE_FUNCTION_ARGS)
+KOKKOS_INLINE_FUNCTION Real reduction_var_shared<Var::eht_lum>(REDUCE_SHARED_ARGS)
 {
-    FourVectors Dtmp;
-    GRMHD::calc_4vecs(G, P, m_p, k, j, i, Loci::center, Dtmp);
     Real rho = P(m_p.RHO, k, j, i);
     Real Pg = (gam - 1.) * P(m_p.UU, k, j, i);
-    Real Bmag = m::sqrt(dot(Dtmp.bcon, Dtmp.bcov));
+    Real Bmag = m::sqrt(dot(D.bcon, D.bcov));
     Real j_eht = rho*rho*rho/Pg/Pg * m::exp(-0.2 * m::cbrt(rho * rho / (Bmag * Pg * Pg)));
     return j_eht;
 }
+template <>
+KOKKOS_INLINE_FUNCTION Real reduction_var<Var::eht_lum>(REDUCE_FUNCTION_ARGS)
+{
+    FourVectors Dtmp;
+    GRMHD::calc_4vecs(G, P, m_p, k, j, i, Loci::center, Dtmp);
+    return reduction_var_shared<Var::eht_lum>(G, P, m_p, U, m_u, cmax, cmin, emhd_params, gam, k, j, i, Dtmp, nullptr);
+}
 
 // Example of checking extra conditions before adding local results:
 // sums total jet power only at exactly r=radius, for areas with sig > 1
 // TODO version w/E&M power only.  Needs "calc_tensor_EM"
 template <>
-KOKKOS_INLINE_FUNCTION Real reduction_var<Var::jet_lum>(REDUCE_FUNCTION_ARGS)
+KOKKOS_INLINE_FUNCTION Real reduction_var_shared<Var::jet_lum>(REDUCE_SHARED_ARGS)
 {
-    FourVectors Dtmp;
-    Real T1[GR_DIM];
-    GRMHD::calc_4vecs(G, P, m_p, k, j, i, Loci::center, Dtmp);
-    Flux::calc_tensor(P, m_p, Dtmp, emhd_params, gam, k, j, i, X1DIR, T1);
     // If sigma > 1...
-    if ((dot(Dtmp.bcon, Dtmp.bcov) / P(m_p.RHO, k, j, i)) > 1.) {
+    if ((dot(D.bcon, D.bcov) / P(m_p.RHO, k, j, i)) > 1.) {
         // Energy flux, like at EH
         return -T1[X0DIR];
     } else {
         return 0.;
     }
 }
+template <>
+KOKKOS_INLINE_FUNCTION Real reduction_var<Var::jet_lum>(REDUCE_FUNCTION_ARGS)
+{
+    FourVectors Dtmp;
+    Real T1[GR_DIM];
+    GRMHD::calc_4vecs(G, P, m_p, k, j, i, Loci::center, Dtmp);
+    Flux::calc_tensor(P, m_p, Dtmp, emhd_params, gam, k, j, i, X1DIR, T1);
+    return reduction_var_shared<Var::jet_lum>(G, P, m_p, U, m_u, cmax, cmin, emhd_params, gam, k, j, i, Dtmp, T1);
+}
 
 // Diagnostics.  Still have to return Real so we get creative.
 template <>
@@ -247,6 +317,40 @@ KOKKOS_INLINE_FUNCTION Real reduction_var<Var::neg_rho>(REDUCE_FUNCTION_ARGS)
     return is_neg;
 }
 
+/**
+ * Runtime dispatch over variables, for batched reductions.
+ * Variables which need them are passed the four-vectors D & tensor row T1,
+ * which should be computed once per zone by the caller (see needs_4vecs, needs_tensor).
+ */
+KOKKOS_INLINE_FUNCTION Real reduction_var_batched(const Var& var, REDUCE_SHARED_ARGS)
+{
+#define REDUCE_SHARED_CALL G, P, m_p, U, m_u, cmax, cmin, emhd_params, gam, k, j, i, D, T1
+#define REDUCE_CALL G, P, m_p, U, m_u, cmax, cmin, emhd_params, gam, k, j, i
+    switch (var) {
+    case Var::phi: return reduction_var<Var::phi>(REDUCE_CALL);
+    case Var::bsq: return reduction_var_shared<Var::bsq>(REDUCE_SHARED_CALL);
+    case Var::gas_pressure: return reduction_var<Var::gas_pressure>(REDUCE_CALL);
+    case Var::mag_pressure: return reduction_var_shared<Var::mag_pressure>(REDUCE_SHARED_CALL);
+    case Var::beta: return reduction_var_shared<Var::beta>(REDUCE_SHARED_CALL);
+    case Var::mdot: return reduction_var_shared<Var::mdot>(REDUCE_SHARED_CALL);
+    case Var::edot: return reduction_var_shared<Var::edot>(REDUCE_SHARED_CALL);
+    case Var::ldot: return reduction_var_shared<Var::ldot>(REDUCE_SHARED_CALL);
+    case Var::mdot_flux: return reduction_var<Var::mdot_flux>(REDUCE_CALL);
+    case Var::edot_flux: return reduction_var<Var::edot_flux>(REDUCE_CALL);
+    case Var::ldot_flux: return reduction_var<Var::ldot_flux>(REDUCE_CALL);
+    case Var::eht_lum: return reduction_var_shared<Var::eht_lum>(REDUCE_SHARED_CALL);
+    case Var::jet_lum: return reduction_var_shared<Var::jet_lum>(REDUCE_SHARED_CALL);
+    case Var::nan_ctop: return reduction_var<Var::nan_ctop>(REDUCE_CALL);
+    case Var::zero_ctop: return reduction_var<Var::zero_ctop>(REDUCE_CALL);
+    case Var::neg_rho: return reduction_var<Var::neg_rho>(REDUCE_CALL);
+    case Var::neg_u: return reduction_var<Var::neg_u>(REDUCE_CALL);
+    case Var::neg_rhout: return reduction_var<Var::neg_rhout>(REDUCE_CALL);
+    }
+#undef REDUCE_CALL
+#undef REDUCE_SHARED_CALL
+    return 0.;
+}
+
 }
 
 #undef REDUCE_FUNCTION_ARGS
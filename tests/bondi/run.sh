@@ -40,6 +40,7 @@ conv_2d eks coordinates/transform=eks "in 2D, EKS coordinates"
 ALL_RES="48,64,96,128"
 conv_2d fmks coordinates/transform=fmks "in 2D, FMKS coordinates"
 conv_2d ks coordinates/transform=null "in 2D, KS coordinates"
+conv_2d fmks_nocache "coordinates/transform=fmks coordinates/cache_geometry=false" "in 2D, FMKS coordinates, on-the-fly metric"
 
 # Recon
 ALL_RES="16,24,32,48,64"
@@ -51,6 +52,19 @@ conv_2d linear_mc GRMHD/reconstruction=linear_mc "in 2D, linear recon with MC li
 conv_2d imex driver/type=imex "in 2D, with Imex driver"
 conv_2d imex_im "driver/type=imex GRMHD/implicit=true" "in 2D, semi-implicit stepping"
 
+# Third-order integrators, keeping a single container for all intermediate stages
+conv_2d rk3_low "parthenon/time/integrator=rk3 driver/low_storage=true" "in 2D, low-storage RK3"
+conv_2d ssprk43_low "parthenon/time/integrator=ssprk43 driver/low_storage=true" "in 2D, low-storage SSPRK(4,3)"
+
+# Multi-rate stepping, subcycling the inner blocks
+conv_2d multirate driver/multirate=true "in 2D, multi-rate stepping"
+
+# Inverting interior zones while boundaries are exchanged
+conv_2d overlap driver/overlap_comms=true "in 2D, overlapping communication"
+
+# Reusing each stage's MeshData rather than rebuilding it every step
+conv_2d cached driver/cache_stage_data=true "in 2D, caching stage data"
+
 # TODO 3D, esp magnetized w/flux, face CT
 
 exit $exit_code
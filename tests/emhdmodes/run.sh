@@ -38,6 +38,10 @@ conv_2d emhd2d_weno driver/reconstruction=weno5 "EMHD mode in 2D, WENO5"
 conv_2d emhd2d_higher_order emhd/higher_order_terms=true "EMHD mode in 2D, higher order terms enabled"
 # Test we can use imex/EMHD and face CT
 conv_2d emhd2d_face_ct b_field/solver=face_ct "EMHD mode in 2D w/Face CT"
+# Test the analytic (automatic differentiation) Jacobian for the implicit solve
+conv_2d emhd2d_analytic_jac implicit/jacobian=analytic "EMHD mode in 2D, analytic Jacobian"
+# Test quasi-Newton iterations with Broyden updates to the Jacobian
+conv_2d emhd2d_broyden implicit/jacobian_update=broyden "EMHD mode in 2D, Broyden Jacobian updates"
 
 ALL_RES="16,32,64,128,256"
 conv_2d emhd2d_mc GRMHD/reconstruction=linear_mc "EMHD mode in 2D, linear/MC reconstruction"
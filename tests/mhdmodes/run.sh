@@ -97,6 +97,9 @@ conv_2d slow_imex_ct   "mhdmodes/nmode=1 driver/type=imex b_field/solver=face_ct
 conv_2d alfven_imex_ct "mhdmodes/nmode=2 driver/type=imex b_field/solver=face_ct" "Alfven mode in 2D, ImEx explicit w/face CT"
 conv_2d fast_imex_ct   "mhdmodes/nmode=3 driver/type=imex b_field/solver=face_ct" "fast mode in 2D, ImEx explicit w/face CT"
 
+# Fused flux kernel
+conv_2d fast_fused    "mhdmodes/nmode=3 driver/fused_flux=true" "fast mode in 2D, fused flux kernel"
+conv_2d fast_fused_ct "mhdmodes/nmode=3 driver/fused_flux=true b_field/solver=face_ct" "fast mode in 2D, fused flux kernel w/face CT"
 
 # simple driver, high res
 ALL_RES="16,24,32,48,64,96,128,192,256"
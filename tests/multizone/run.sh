@@ -138,3 +138,16 @@ do
     r_in=$((${r_in}*$BASE))
   fi
 done
+
+# The same zone schedule, run in a single process over the whole domain.
+# One MeshBlock per factor of BASE in radius, so each annulus is exactly two blocks
+nx1_zone=32
+$KHARMA_DIR/run.sh -n 1 -i ${parfilename} \
+                    parthenon/time/tlim=$(($NRUNS*10)) \
+                    parthenon/mesh/nx1=$(($nx1_zone*($NZONES+1))) parthenon/meshblock/nx1=$nx1_zone \
+                    coordinates/transform=eks coordinates/r_in=1 coordinates/r_out=$((${BASE}**($NZONES+1))) \
+                    bondi/r_shell=$((${BASE}**($NZONES+1)/2)) \
+                    b_field/bz=${bz} b_field/initial_cleanup=1 \
+                    multizone/on=true multizone/nzones=$NZONES multizone/base=$BASE multizone/zone_time=10 \
+                    parthenon/output0/dt=1 parthenon/output1/dt=2 parthenon/output2/dt=1 \
+                    -d ${DR}/bondi_multizone_native 1> ${PDR}/logs/${DRTAG}/log_multizone_native_out 2>${PDR}/logs/${DRTAG}/log_multizone_native_err
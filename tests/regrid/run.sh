@@ -50,4 +50,27 @@ else
     echo Resize test success
 fi
 
+# Resize again, cleaning the field with a direct FFT solve rather than BiCGStab
+# Move the first result aside, so this check can't pass on it
+mv resize_restart.out1.final.rhdf resize_restart.out1.final.bicgstab.rhdf
+
+run_code=0
+$KHARMADIR/run.sh -i ./resize_orszag_tang.par b_cleanup/solver=fft >log_resize_fft.txt 2>&1 || run_code=$?
+
+if [[ $run_code != 0 ]] && grep -q "compiled without FFTW" log_resize_fft.txt; then
+    echo Resize FFT test skipped: KHARMA was compiled without FFTW
+elif [[ $run_code != 0 ]]; then
+    echo Resize FFT test FAIL: run exited with $run_code
+    exit_code=1
+else
+    check_code=0
+    pyharm-check-basics resize_restart.out1.final.rhdf || check_code=$?
+    if [[ $check_code != 0 ]]; then
+        echo Resize FFT test FAIL: $check_code
+        exit_code=1
+    else
+        echo Resize FFT test success
+    fi
+fi
+
 exit $exit_code
@@ -20,6 +20,19 @@ mv torus.out0.final.phdf torus.out0.final.restart.phdf
 # Compare to some high degree of accuracy
 # TODO this was formerly 1e-11, we may need to clean up restarting & sequencing of the first steps
 pyharm diff --rel_tol 1e-9 torus.out0.final.init.phdf torus.out0.final.restart.phdf -o compare_restart
+
+# Same, with the SSPRK(4,3) integrator, which must survive being stored as RK3 in the restart file
+$KHARMADIR/run.sh -i $KHARMADIR/pars/tori_3d/sane.par parthenon/time/nlim=5 parthenon/time/integrator=ssprk43 >log_restart_ssprk43_1.txt 2>&1
+
+mv torus.out0.final.phdf torus.out0.final.init_ssprk43.phdf
+
+sleep 1
+
+$KHARMADIR/run.sh -r torus.out1.00000.rhdf parthenon/time/nlim=5 >log_restart_ssprk43_2.txt 2>&1
+
+mv torus.out0.final.phdf torus.out0.final.restart_ssprk43.phdf
+
+pyharm diff --rel_tol 1e-9 torus.out0.final.init_ssprk43.phdf torus.out0.final.restart_ssprk43.phdf -o compare_restart_ssprk43
 # Compare binary. Sometimes works but not worth keeping always
 #h5diff --exclude-path=/Info \
 #       --exclude-path=/Input \
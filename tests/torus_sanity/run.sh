@@ -13,5 +13,8 @@ check_sanity() {
 
 check_sanity imex driver/type=imex
 check_sanity harm driver/type=harm
+check_sanity fused_utop "driver/type=kharma driver/fused_utop=true"
+check_sanity compact_seed "driver/type=kharma inverter/compact_seed=true"
+check_sanity block_cost "driver/type=kharma block_cost/on=true block_cost/interval=5"
 
 exit $exit_code